@@ -34,11 +34,14 @@ struct keyword {
 	unsigned char token, value;
 };
 
+/*
+ * Fields are ordered by use: the ones read by eqtype() and mktype()
+ * come first and fit in half a cache line, without padding holes.
+ */
 struct type {
 	unsigned char op;           /* type builder operator */
-	char ns;                    /* namespace for struct members */
-	short id;                   /* type id, used in dcls */
 	char letter;                /* letter of the type */
+	char ns;                    /* namespace for struct members */
 	bool defined : 1;           /* type defined */
 	bool sign : 1;              /* signess of the type */
 	bool printed : 1;           /* the type already was printed */
@@ -46,29 +49,36 @@ struct type {
 	bool arith : 1;             /* this type is INT, ENUM, FLOAT */
 	bool aggreg : 1;            /* this type is struct or union */
 	bool k_r : 1;               /* This is a k&r function */
-	size_t size;                /* sizeof the type */
-	size_t align;               /* align of the type */
+	unsigned id;                /* type id, used in dcls */
 	Type *type;                 /* base type */
-	Symbol *tag;                /* symbol of the strug tag */
-	Type *next;                 /* next element in the hash */
-	union {
-		Type **pars;            /* Function type parameters */
-		Symbol **fields;        /* fields of aggregate type */
-	} p;
 	union {
 		unsigned char rank;     /* convertion rank */
 		TINT elem;              /* number of type parameters */
 	} n;
+	union {
+		Type **pars;            /* Function type parameters */
+		Symbol **fields;        /* fields of aggregate type */
+	} p;
+	Type *next;                 /* next element in the hash */
+	Symbol *tag;                /* symbol of the strug tag */
+	size_t size;                /* sizeof the type */
+	size_t align;               /* align of the type */
 };
 
+/*
+ * The fields used by lookup() go first, and the full hash value
+ * of the name is kept to avoid most of the string comparisons.
+ */
 struct symbol {
+	struct symbol *hash;
 	char *name;
-	Type *type;
-	unsigned short id;
-	unsigned char ctx;
+	unsigned hval;
+	unsigned ctx;
 	char ns;
 	unsigned char token;
 	short flags;
+	unsigned id;
+	Type *type;
 	union {
 		TINT i;
 		TUINT u;
@@ -78,16 +88,16 @@ struct symbol {
 		Symbol **pars;
 	} u;
 	struct symbol *next;
-	struct symbol *hash;
 };
 
 struct node {
 	unsigned char op;
-	Type *type;
-	Symbol *sym;
 	bool lvalue : 1;
 	bool symbol: 1;
 	bool constant : 1;
+	unsigned vn;                /* value number, used in cse.c */
+	Type *type;
+	Symbol *sym;
 	struct node *left, *right;
 };
 
@@ -98,7 +108,7 @@ struct scase {
 };
 
 struct caselist {
-	short nr;
+	int nr;
 	Symbol *deflabel;
 	Symbol *ltable;
 	Symbol *lbreak;
@@ -319,6 +329,7 @@ enum op {
 /* error.c */
 extern void error(char *fmt, ...);
 extern void warn(char *fmt, ...);
+extern void pedwarn(char *fmt, ...);
 extern void unexpected(void);
 extern void errorp(char *fmt, ...);
 extern void cpperror(char *fmt, ...);
@@ -328,10 +339,13 @@ extern bool eqtype(Type *tp1, Type *tp2);
 extern Type *ctype(unsigned type, unsigned sign, unsigned size);
 extern Type *mktype(Type *tp, int op, TINT nelem, Type *data[]);
 extern Type *duptype(Type *base);
+extern TINT typesize(Type *tp);
 extern struct limits *getlimits(Type *tp);
+extern void typestats(void);
 
 /* symbol.c */
 extern void dumpstab(char *msg);
+extern void symstats(void);
 extern Symbol *lookup(int ns, char *name);
 extern Symbol *nextsym(Symbol *sym, int ns);
 extern Symbol *install(int ns, Symbol *sym);
@@ -339,6 +353,7 @@ extern Symbol *newsym(int ns);
 extern void pushctx(void), popctx(void);
 extern void killsym(Symbol *sym);
 extern Symbol *newlabel(void);
+extern Symbol *newtemp(Type *tp);
 extern void keywords(struct keyword *key, int ns);
 
 /* stmt.c */
@@ -361,11 +376,15 @@ extern void ilex(char *fname);
 
 /* code.c */
 extern void emit(unsigned, void *);
+extern void flushout(void);
+extern void (*irfun)(char *buf, size_t len);
+extern void binaryir(void);
 extern Node *node(unsigned op, Type *tp, Node *left, Node *rigth);
 extern Node *varnode(Symbol *sym);
 extern Node *constnode(Symbol *sym);
 extern Node *sizeofnode(Type *tp);
-extern void freetree(Node *np);
+extern unsigned marknodes(void);
+extern void freenodes(unsigned mark);
 #define BTYPE(np) ((np)->type->op)
 
 /* fold.c */
@@ -383,6 +402,9 @@ extern bool cmpnode(Node *np, TUINT val);
 extern Node *decay(Node *np);
 extern void initializer(Symbol *sym, Type *tp, int nelem);
 
+/* cse.c */
+extern Node *cse(Node *np);
+
 /* cpp.c */
 extern void icpp(void);
 extern bool cpp(void);
@@ -1,12 +1,18 @@
 
+#include <errno.h>
 #include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
 
 #include "../inc/cc.h"
 #include "cc1.h"
 
+#define NR_NODEBLK 512
+#define NR_OUTBUF 8192
+
 static void emitbin(unsigned, void *),
             emitswitcht(unsigned, void *),
             emitcast(unsigned, void *),
@@ -57,11 +63,10 @@ char *optxt[] = {
 	[OOR] = "o",
 	[OASK] = "?",
 	[OCOMMA] = ",",
-	[OLABEL] = "L%d\n",
-	[ODEFAULT] = "\tf\tL%d\n",
-	[OCASE] = "\tv\tL%d",
-	[OJUMP] = "\tj\tL%d\n",
-	[OBRANCH] = "\tj\tL%d",
+	[ODEFAULT] = "\tf",
+	[OCASE] = "\tv",
+	[OJUMP] = "\tj",
+	[OBRANCH] = "\tj",
 	[OEFUN] = "}\n",
 	[OELOOP] = "\tb\n",
 	[OBLOOP] = "\te\n",
@@ -132,14 +137,125 @@ void (*opcode[])(unsigned, void *) = {
 	[OINIT] = emitinit
 };
 
+/*
+ * The IR is written by hand in a buffer, which is flushed with
+ * a single write() when it is full and at the end of the program.
+ * When the back end runs in the same process irfun is set, and
+ * the buffer grows to keep the IR of a full function, which is
+ * passed to irfun at the end of the function.
+ */
+void (*irfun)(char *buf, size_t len);
+static char *outbuf, *outp, *outlim;
+static int binary;
+static int lead;                /* the tab before the expression is out */
+
 void
-freetree(Node *np)
+flushout(void)
 {
-	if (!np)
+	extern int failure;
+	char *bp = outbuf;
+	ssize_t n;
+
+	if (irfun) {
+		if (!failure && outp > outbuf)
+			(*irfun)(outbuf, outp - outbuf);
+		outp = outbuf;
 		return;
-	freetree(np->left);
-	freetree(np->right);
-	free(np);
+	}
+	while (bp < outp) {
+		if ((n = write(1, bp, outp - bp)) < 0) {
+			if (errno == EINTR)
+				continue;
+			die("error writing output:%s", strerror(errno));
+		}
+		bp += n;
+	}
+	outp = outbuf;
+}
+
+static void
+growout(void)
+{
+	size_t siz = outlim - outbuf, len = outp - outbuf;
+
+	if (outbuf && !irfun) {
+		flushout();
+		return;
+	}
+	siz = (siz) ? 2*siz : NR_OUTBUF;
+	outbuf = xrealloctag(outbuf, siz, MEM_STRING);
+	outp = outbuf + len;
+	outlim = outbuf + siz;
+}
+
+static void
+outc(int c)
+{
+	if (outp == outlim)
+		growout();
+	*outp++ = c;
+}
+
+static void
+outs(char *s)
+{
+	while (*s)
+		outc(*s++);
+}
+
+static void
+outnum(TUINT u, int base)
+{
+	char buf[sizeof(u) * 3], *bp = &buf[sizeof(buf)];
+
+	if (binary) {
+		for ( ; u > 0x7F; u >>= 7)
+			outc(u & 0x7F | 0x80);
+		outc(u);
+		return;
+	}
+	do
+		*--bp = "0123456789ABCDEF"[u % base];
+	while (u /= base);
+	while (bp < &buf[sizeof(buf)])
+		outc(*bp++);
+}
+
+static void
+outsep(void)
+{
+	if (!binary)
+		outc('\t');
+}
+
+static void
+outname(char *s)
+{
+	size_t len;
+
+	if (binary) {
+		len = (s) ? strlen(s) : 0;
+		outnum(len, 10);
+		while (len-- > 0)
+			outc(*s++);
+	} else if (s) {
+		outc('\t');
+		outs(s);
+	}
+}
+
+/*
+ * The binary form of the IR is the text form without separators
+ * and with numbers written as varints, 7 bits per byte with the
+ * upper bit set in all the bytes but the last. Names and strings
+ * are prefixed by their length, and the suboperator of :op is
+ * written alone with the upper bit set.
+ */
+void
+binaryir(void)
+{
+	binary = 1;
+	outc(IR_MAGIC);
 }
 
 static void
@@ -157,6 +273,8 @@ emit(unsigned op, void *arg)
 	if (failure)
 		return;
 	(*opcode[op])(op, arg);
+	if (op == OEFUN && irfun)
+		flushout();
 }
 
 static void
@@ -179,7 +297,8 @@ emitvar(Symbol *sym)
 		c = L_EXTERN;
 	else
 		c = L_AUTO;
-	printf("%c%u", c, sym->id);
+	outc(c);
+	outnum(sym->id, 10);
 }
 
 static void
@@ -188,25 +307,29 @@ emitconst(Node *np)
 	char *bp, c;
 	Symbol *sym = np->sym;
 	Type *tp = np->type;
-	TUINT u;
 
 	switch (tp->op) {
 	case PTR:
 	case INT:
 	case ENUM:
-		u = (tp->sign) ? (TUINT) sym->u.i : sym->u.u;
-		printf("#%c%llX",
-		       np->type->letter,
-		       (long long) sym->u.i & ones(tp->size));
+		outc('#');
+		outc(np->type->letter);
+		outnum(sym->u.u & ones(tp->size), 16);
 		break;
 	case ARY:
 		/*
 		 * FIX: At this point we are going to assume
 		 * that all the arrays are strings
 		 */
-		putchar('"');
-		for (bp = sym->u.s; c = *bp; ++bp)
-			printf("%02X", c & 0xFF);
+		outc('"');
+		if (binary) {
+			outname(sym->u.s);
+			break;
+		}
+		for (bp = sym->u.s; c = *bp; ++bp) {
+			outc("0123456789ABCDEF"[(c >> 4) & 0xF]);
+			outc("0123456789ABCDEF"[c & 0xF]);
+		}
 		break;
 	default:
 		/* TODO: Handle other kind of constants */
@@ -218,20 +341,24 @@ static void
 emitsym(unsigned op, void *arg)
 {
 	Node *np = arg;
-	putchar('\t');
+
+	if (lead)
+		lead = 0;
+	else
+		outsep();
 	(np->constant) ? emitconst(np) : emitvar(np->sym);
 }
 
 static void
 emitletter(Type *tp)
 {
-	putchar(tp->letter);
+	outc(tp->letter);
 	switch (tp->op) {
 	case ARY:
 	case FTN:
 	case STRUCT:
 	case UNION:
-		printf("%u", tp->id);
+		outnum(tp->id, 10);
 	}
 }
 
@@ -241,7 +368,6 @@ emittype(Type *tp)
 	TINT n;
 	Type **vp;
 	Symbol **sp;
-	char *tag;
 
 	if (tp->printed || !tp->defined)
 		return;
@@ -251,9 +377,12 @@ emittype(Type *tp)
 	case ARY:
 		emittype(tp->type);
 		emitletter(tp);
-		putchar('\t');
+		outsep();
 		emitletter(tp->type);
-		printf("\t#%d\n", tp->n.elem);
+		outsep();
+		outc('#');
+		outnum(tp->n.elem, 10);
+		outc('\n');
 		return;
 	case PTR:
 		emittype(tp->type);
@@ -264,23 +393,22 @@ emittype(Type *tp)
 		for (sp = tp->p.fields; n-- > 0; ++sp)
 			emittype((*sp)->type);
 		emitletter(tp);
-		if ((tag = tp->tag->name) != NULL)
-			printf("\t%s", tag);
-		putchar('\n');
+		outname(tp->tag->name);
+		outc('\n');
 		n = tp->n.elem;
 		for (sp = tp->p.fields; n-- > 0; ++sp)
 			emit(ODECL, *sp);
 		break;
 	case FTN:
 		emitletter(tp);
-		putchar('\t');
+		outsep();
 		emitletter(tp->type);
 		n = tp->n.elem;
 		for (vp = tp->p.pars; n-- > 0; ++vp) {
-			putchar('\t');
+			outsep();
 			emitletter(*vp);
 		}
-		putchar('\n');
+		outc('\n');
 		return;
 	default:
 		abort();
@@ -292,11 +420,9 @@ emitinit(unsigned op, void *arg)
 {
 	Node *np = arg;
 
-	puts("(");
+	outs("(\n");
 	emitexp(OEXPR, np->right);
-	puts(")");
-	np->right = NULL;
-	freetree(np);
+	outs(")\n");
 }
 
 static void
@@ -308,12 +434,11 @@ emitdcl(unsigned op, void *arg)
 		return;
 	emittype(sym->type);
 	emitvar(sym);
-	putchar('\t');
+	outsep();
 	emitletter(sym->type);
-	if (sym->name)
-		printf("\t%s", sym->name);
+	outname(sym->name);
 	if (op != OFUN)
-		putchar('\n');
+		outc('\n');
 	sym->flags |= ISEMITTED;
 }
 
@@ -323,8 +448,11 @@ emitcast(unsigned op, void *arg)
 	Node *np = arg, *lp = np->left;
 
 	emitnode(lp);
-	if (np->type != voidtype)
-		printf("\tg%c", np->type->letter);
+	if (np->type != voidtype) {
+		outsep();
+		outc('g');
+		outc(np->type->letter);
+	}
 }
 
 static void
@@ -336,19 +464,32 @@ emitbin(unsigned op, void *arg)
 	emitnode(np->left);
 	emitnode(np->right);
 	if ((s = optxt[op]) != NULL)  {      /* do not print in OCOLON case */
-		printf("\t%s", optxt[op]);
+		outsep();
+		if (binary && s[0] == ':' && s[1])
+			outc(s[1] | 0x80);
+		else
+			outs(s);
 		emitletter(np->type);
 	}
 }
 
+/*
+ * A statement begins with a tab in both forms, because it is the
+ * only thing that differentiates it from a declaration. The first
+ * node of an expression is always a symbol, which does not write
+ * its separator then.
+ */
 static void
 emitexp(unsigned op, void *arg)
 {
 	Node *np = arg;
 
+	if (np) {
+		outc('\t');
+		lead = 1;
+	}
 	emitnode(np);
-	putchar('\n');
-	freetree(np);
+	outc('\n');
 }
 
 static void
@@ -357,26 +498,34 @@ emitfun(unsigned op, void *arg)
 	Symbol *sym = arg, **sp;
 
 	emitdcl(op, arg);
-	puts("\n{");
+	outs("\n{\n");
 
 	for (sp = sym->u.pars; sp && *sp; ++sp)
 		emit(ODECL, *sp);
-	puts("\\");
-	free(sym->u.pars);
+	outs("\\\n");
+	xfree(sym->u.pars);
 	sym->u.pars = NULL;
 }
 
 static void
 emittext(unsigned op, void *arg)
 {
-	fputs(optxt[op], stdout);
+	outs(optxt[op]);
 }
 
 static void
 emitsymid(unsigned op, void *arg)
 {
 	Symbol *sym = arg;
-	printf(optxt[op], sym->id);
+
+	if (op != OLABEL) {
+		outs(optxt[op]);
+		outsep();
+	}
+	outc('L');
+	outnum(sym->id, 10);
+	if (op != OCASE && op != OBRANCH)
+		outc('\n');
 }
 
 static void
@@ -384,7 +533,10 @@ emitswitch(unsigned op, void *arg)
 {
 	Caselist *lcase = arg;
 
-	printf("\ts\tL%u", lcase->ltable->id);
+	outs("\ts");
+	outsep();
+	outc('L');
+	outnum(lcase->ltable->id, 10);
 	emitexp(OEXPR, lcase->expr);
 }
 
@@ -394,23 +546,53 @@ emitswitcht(unsigned op, void *arg)
 	Caselist *lcase = arg;
 	struct scase *p, *next;
 
-	printf("\tt\t#%0x\n", lcase->nr);
+	outs("\tt");
+	outsep();
+	outc('#');
+	outnum(lcase->nr, 16);
+	outc('\n');
 	for (p = lcase->head; p; p = next) {
 		emitsymid(OCASE, p->label);
 		emitexp(OEXPR, p->expr);
 		next = p->next;
-		free(p);
+		xfree(p);
 	}
 	if (lcase->deflabel)
 		emitsymid(ODEFAULT, lcase->deflabel);
 }
 
+/*
+ * Nodes are taken from blocks of NR_NODEBLK nodes which are never
+ * freed. Trees are not released one by one, instead the parser
+ * marks the position before a statement and frees all the nodes
+ * allocated after it once the statement has been emitted.
+ */
+static Node **nodeblks;
+static unsigned nrnodes, nrblks;
+
+unsigned
+marknodes(void)
+{
+	return nrnodes;
+}
+
+void
+freenodes(unsigned mark)
+{
+	nrnodes = mark;
+}
+
 Node *
 node(unsigned op, Type *tp, Node *lp, Node *rp)
 {
 	Node *np;
+	unsigned n;
 
-	np = xmalloc(sizeof(*np));
+	if ((n = nrnodes / NR_NODEBLK) == nrblks) {
+		nodeblks = xrealloc(nodeblks, ++nrblks * sizeof(*nodeblks));
+		nodeblks[n] = xmalloctag(NR_NODEBLK * sizeof(Node), MEM_NODE);
+	}
+	np = &nodeblks[n][nrnodes++ % NR_NODEBLK];
 	np->op = op;
 	np->type = tp;
 	np->sym = NULL;
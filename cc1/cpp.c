@@ -18,7 +18,8 @@
 static char *argp, *macroname;
 static unsigned arglen;
 static Symbol *symline, *symfile;
-static unsigned char ifstatus[NR_COND];
+static unsigned char *ifstatus;
+static unsigned nrifstatus;
 static int ninclude;
 static char **dirinclude;
 
@@ -33,7 +34,7 @@ defmacro(char *s)
 
 	if ((p = strchr(s, '=')) != NULL) {
 		*p++='\0';
-		q = xmalloc(strlen(p) + 4);
+		q = xmalloctag(strlen(p) + 4, MEM_STRING);
 		sprintf(q, "-1#%s", p);
 		p = q;
 	}
@@ -154,16 +155,16 @@ parsepars(char *buffer, char **listp, int nargs)
 	arglen = INPUTSIZ;
 	if (yytoken != ')') {
 		do {
-			*listp++ = argp;
+			if (n < nargs)
+				listp[n] = argp;
 			parameter();
-		} while (++n < NR_MACROARG && yytoken == ',');
+			++n;
+		} while (yytoken == ',');
 	}
 	if (yytoken != ')')
 		error("incorrect macro function alike invocation");
 	disexpand = 0;
 
-	if (n == NR_MACROARG)
-		error("too much parameters in macro \"%s\"", macroname);
 	if (n != nargs) {
 		error("macro \"%s\" passed %d arguments, but it takes %d",
 		      macroname, n, nargs);
@@ -207,7 +208,7 @@ copymacro(char *buffer, char *s, size_t bufsiz, char *arglist[])
 		} else {
 			if (prevc == '#')
 				bufsiz -= 2;
-			arg = arglist[atoi(++s)];
+			arg = arglist[strtoul(++s, &s, 10)];
 			size = strlen(arg);
 			if (size > bufsiz)
 				goto expansion_too_long;
@@ -218,7 +219,6 @@ copymacro(char *buffer, char *s, size_t bufsiz, char *arglist[])
 			if (prevc == '#')
 				*bp++ = '"';
 			bufsiz -= size;
-			s += 2;
 		}
 	}
 	*bp = '\0';
@@ -233,10 +233,12 @@ expansion_too_long:
 bool
 expand(char *begin, Symbol *sym)
 {
+	static char **arglist;
+	static int maxargs;
 	size_t total, elen, rlen, llen, ilen;
-	int n;
+	int n, nargs;
 	char *s = sym->u.s;
-	char *arglist[NR_MACROARG], arguments[INPUTSIZ], buffer[BUFSIZE];
+	char arguments[INPUTSIZ], buffer[BUFSIZE];
 
 	macroname = sym->name;
 	if ((sym->flags & ISDECLARED) == 0) {
@@ -260,12 +262,16 @@ expand(char *begin, Symbol *sym)
 		goto substitute;
 	}
 
-	if (!parsepars(arguments, arglist, atoi(s)))
+	if ((nargs = atoi(s)) > maxargs) {
+		maxargs = nargs;
+		arglist = xrealloc(arglist, nargs * sizeof(*arglist));
+	}
+	if (!parsepars(arguments, arglist, nargs))
 		return 0;
-	for (n = 0; n < atoi(s); ++n)
+	for (n = 0; n < nargs; ++n)
 		DBG("MACRO par%d:%s", n, arglist[n]);
 
-	elen = copymacro(buffer, s+3, INPUTSIZ-1, arglist);
+	elen = copymacro(buffer, strchr(s, '#')+1, INPUTSIZ-1, arglist);
 
 substitute:
 	DBG("MACRO '%s' expanded to :'%s'", macroname, buffer);
@@ -294,26 +300,30 @@ substitute:
 }
 #undef BUFSIZE
 
-static int
-getpars(Symbol *args[NR_MACROARG])
+static bool
+getpars(Symbol ***argsp, int *nargsp)
 {
+	static Symbol **args;
+	static int maxargs;
 	int n = -1;
 	Symbol *sym;
 
 	if (!accept('('))
-		return n;
+		goto done;
 	++n;
 	if (accept(')'))
-		return n;
+		goto done;
 
 	do {
-		if (n == NR_MACROARG) {
-			cpperror("too much parameters in macro");
-			return NR_MACROARG;
-		}
+		if (n == NR_MACROARG)
+			pedwarn("more than %d parameters in macro", NR_MACROARG);
 		if (yytoken != IDEN) {
 			cpperror("macro arguments must be identifiers");
-			return NR_MACROARG;
+			return 0;
+		}
+		if (n == maxargs) {
+			maxargs = (n) ? 2*n : NR_MACROARG;
+			args = xrealloc(args, maxargs * sizeof(*args));
 		}
 		sym = install(NS_IDEN, yylval.sym);
 		sym->flags |= ISUSED;
@@ -322,11 +332,14 @@ getpars(Symbol *args[NR_MACROARG])
 	} while (accept(','));
 	expect(')');
 
-	return n;
+done:
+	*argsp = args;
+	*nargsp = n;
+	return 1;
 }
 
 static bool
-getdefs(Symbol *args[NR_MACROARG], int nargs, char *bp, size_t bufsiz)
+getdefs(Symbol *args[], int nargs, char *bp, size_t bufsiz)
 {
 	Symbol **argp;
 	size_t len;
@@ -379,9 +392,9 @@ getdefs(Symbol *args[NR_MACROARG], int nargs, char *bp, size_t bufsiz)
 static void
 define(void)
 {
-	Symbol *sym,*args[NR_MACROARG];
+	Symbol *sym, **args;
 	char buff[LINESIZ+1];
-	int n;
+	int n, len;
 
 	if (cppoff)
 		return;
@@ -396,7 +409,7 @@ define(void)
 	sym = yylval.sym;
 	if (sym->flags & ISDECLARED) {
 		warn("'%s' redefined", yytext);
-		free(sym->u.s);
+		xfree(sym->u.s);
 	} else {
 		sym = install(NS_CPP, sym);
 		sym->flags |= ISDECLARED|ISSTRING;
@@ -404,10 +417,10 @@ define(void)
 
 	namespace = NS_IDEN;       /* Avoid polution in NS_CPP */
 	next();
-	if ((n = getpars(args)) == NR_MACROARG)
+	if (!getpars(&args, &n))
 		goto delete;
-	sprintf(buff, "%02d#", n);
-	if (!getdefs(args, n, buff+3, LINESIZ-3))
+	len = sprintf(buff, "%02d#", n);
+	if (!getdefs(args, n, buff+len, LINESIZ-len))
 		goto delete;
 	sym->u.s = xstrdup(buff);
 	DBG("MACRO '%s' defined as '%s'", sym->name, buff);
@@ -536,7 +549,7 @@ line(void)
 		return;
 	}
 
-	free(input->fname);
+	xfree(input->fname);
 	input->fname = xstrdup(yylval.sym->u.s);
 	next();
 
@@ -571,8 +584,13 @@ ifclause(int negate, int isifdef)
 	int status;
 	Node *expr;
 
-	if (cppctx == NR_COND-1)
-		error("too much nesting levels of conditional inclusion");
+	if (cppctx == NR_COND)
+		pedwarn("more than %d nesting levels of conditional inclusion",
+		        NR_COND);
+	if (cppctx == nrifstatus) {
+		nrifstatus = (cppctx) ? 2*cppctx : NR_COND;
+		ifstatus = xrealloc(ifstatus, nrifstatus);
+	}
 
 	n = cppctx++;
 	namespace = NS_CPP;
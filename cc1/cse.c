@@ -0,0 +1,293 @@
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "../inc/cc.h"
+#include "cc1.h"
+
+#define NR_VN_HASH 32
+
+/*
+ * Value numbering of a full expression. All the equal subtrees
+ * without side effects share an entry, and when the value of an
+ * entry is used more than once, the first occurrence is stored
+ * in a temporary variable, which replaces the next occurrences.
+ * The first occurrence must be evaluated always, so it cannot be
+ * in the right side of && or || or in the branches of ?:. The
+ * IR does not define the order of evaluation of the operands, so
+ * the temporaries are assigned in a comma before the expression.
+ */
+struct vn {
+	Node *np;               /* node used to compare */
+	unsigned hash;
+	int n;                  /* number of occurrences */
+	int uses;               /* occurrences replaced by the temporary */
+	Node *tmp;              /* variable holding the value */
+	Node *def;              /* occurrence stored in the temporary */
+	Node **defp;            /* place of the stored occurrence */
+	int order;              /* next entry in the order of definition */
+	int next;               /* next entry in the hash chain */
+};
+
+static struct vn *vns;
+static int nrvns, maxvns;
+static int vntab[NR_VN_HASH];
+static int first, *last;
+
+static bool
+sideeffect(Node *np)
+{
+	if (!np)
+		return 0;
+	switch (np->op) {
+	case OASSIGN:
+	case OA_MUL:
+	case OA_DIV:
+	case OA_MOD:
+	case OA_ADD:
+	case OA_SUB:
+	case OA_SHL:
+	case OA_SHR:
+	case OA_AND:
+	case OA_XOR:
+	case OA_OR:
+	case OINC:
+	case ODEC:
+	case OCALL:
+		return 1;
+	default:
+		return sideeffect(np->left) || sideeffect(np->right);
+	}
+}
+
+/*
+ * The left operand of these operators is an object,
+ * not a value
+ */
+static bool
+isobject(int op)
+{
+	switch (op) {
+	case OADDR:
+	case OFIELD:
+	case OINC:
+	case ODEC:
+		return 1;
+	default:
+		return op >= OASSIGN && op <= OA_OR;
+	}
+}
+
+static bool
+candidate(Node *np)
+{
+	if (np->op >= OASSIGN && np->op <= OA_OR)
+		return 0;
+	switch (np->op) {
+	case OSYM:
+	case OCOMMA:
+	case OASK:
+	case OCOLON:
+	case OAND:
+	case OOR:
+		return 0;
+	case OADDR:
+		/* the address of a variable is already a constant */
+		if (np->left->op == OSYM)
+			return 0;
+	}
+	switch (np->type->op) {
+	case INT:
+	case ENUM:
+	case PTR:
+	case FLOAT:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+static unsigned
+hashnode(Node *np)
+{
+	unsigned h;
+
+	if (!np)
+		return 0;
+	h = np->op;
+	h = h*33 ^ (unsigned) ((uintptr_t) np->type >> 3);
+	if (np->op == OSYM) {
+		if (np->constant)
+			h = h*33 ^ (unsigned) np->sym->u.u;
+		else
+			h = h*33 ^ (unsigned) ((uintptr_t) np->sym >> 3);
+	}
+	h = h*33 ^ hashnode(np->left);
+	return h*33 ^ hashnode(np->right);
+}
+
+static bool
+eqnode(Node *lp, Node *rp)
+{
+	Symbol *ls, *rs;
+
+	if (!lp || !rp)
+		return lp == rp;
+	if (lp->op != rp->op || lp->type != rp->type)
+		return 0;
+	if (lp->op == OSYM) {
+		ls = lp->sym, rs = rp->sym;
+		if (!lp->constant || !rp->constant)
+			return ls == rs;
+		if (lp->type->op == FLOAT)
+			return ls->u.f == rs->u.f;
+		return ls->u.u == rs->u.u;
+	}
+	return eqnode(lp->left, rp->left) && eqnode(lp->right, rp->right);
+}
+
+static struct vn *
+lookupvn(Node *np)
+{
+	struct vn *vp;
+	unsigned h;
+	int *bp, i;
+
+	h = hashnode(np);
+	bp = &vntab[h & NR_VN_HASH-1];
+	for (i = *bp; i >= 0; i = vp->next) {
+		vp = &vns[i];
+		if (vp->hash == h && eqnode(vp->np, np))
+			return vp;
+	}
+
+	if (nrvns == maxvns) {
+		maxvns = (maxvns) ? 2*maxvns : NR_VN_HASH;
+		vns = xrealloc(vns, maxvns * sizeof(*vns));
+	}
+	vp = &vns[nrvns];
+	vp->np = np;
+	vp->hash = h;
+	vp->n = vp->uses = 0;
+	vp->tmp = vp->def = NULL;
+	vp->defp = NULL;
+	vp->next = *bp;
+	*bp = nrvns++;
+	return vp;
+}
+
+static void
+count(Node *np, int cond, int object)
+{
+	struct vn *vp;
+
+	if (!np)
+		return;
+	if (!object && candidate(np)) {
+		vp = lookupvn(np);
+		np->vn = vp - vns;
+		if (!cond || vp->n > 0)
+			++vp->n;
+	}
+	count(np->left, cond, isobject(np->op));
+	switch (np->op) {
+	case OAND:
+	case OOR:
+	case OASK:
+		cond = 1;
+	}
+	count(np->right, cond, 0);
+}
+
+static void
+rewrite(Node **pp, int cond, int object)
+{
+	Node *np = *pp;
+	struct vn *vp = NULL;
+
+	if (!np)
+		return;
+	if (!object && candidate(np)) {
+		vp = &vns[np->vn];
+		if (vp->tmp) {
+			++vp->uses;
+			*pp = node(OSYM, np->type, NULL, NULL);
+			**pp = *vp->tmp;
+			return;
+		}
+		if (vp->n > 1 && !cond) {
+			vp->tmp = varnode(newtemp(np->type));
+			vp->def = np;
+			vp->defp = pp;
+			*pp = node(OSYM, np->type, NULL, NULL);
+			**pp = *vp->tmp;
+		} else {
+			vp = NULL;
+		}
+	}
+	rewrite(&np->left, cond, isobject(np->op));
+	switch (np->op) {
+	case OAND:
+	case OOR:
+	case OASK:
+		cond = 1;
+	}
+	rewrite(&np->right, cond, 0);
+
+	/* the temporaries used in the definition are already defined */
+	if (vp) {
+		vp->order = -1;
+		*last = vp - vns;
+		last = &vp->order;
+	}
+}
+
+Node *
+cse(Node *np)
+{
+	struct vn *vp;
+	Node *defs;
+	int i;
+
+	if (!np)
+		return NULL;
+	/* only an assignment at the top can have side effects */
+	if (np->op >= OASSIGN && np->op <= OA_OR) {
+		if (sideeffect(np->left) || sideeffect(np->right))
+			return np;
+	} else if (sideeffect(np)) {
+		return np;
+	}
+
+	nrvns = 0;
+	for (i = 0; i < NR_VN_HASH; ++i)
+		vntab[i] = -1;
+	count(np, 0, 0);
+	first = -1;
+	last = &first;
+	rewrite(&np, 0, 0);
+
+	/* undo the temporaries whose value was not used */
+	for (i = nrvns-1; i >= 0; --i) {
+		vp = &vns[i];
+		if (vp->tmp && vp->uses == 0)
+			*vp->defp = vp->def;
+	}
+
+	defs = NULL;
+	for (i = first; i >= 0; i = vp->order) {
+		vp = &vns[i];
+		if (vp->uses == 0)
+			continue;
+		emit(ODECL, vp->tmp->sym);
+		vp->def = node(OASSIGN, vp->def->type, vp->tmp, vp->def);
+		if (defs)
+			defs = node(OCOMMA, vp->def->type, defs, vp->def);
+		else
+			defs = vp->def;
+	}
+	if (defs)
+		np = node(OCOMMA, np->type, defs, np);
+	return np;
+}
@@ -13,14 +13,21 @@
 #define NOSCLASS  0
 
 struct declarators {
-	unsigned char nr;
+	unsigned nr, max;
 	struct declarator {
 		unsigned char op;
 		TINT  nelem;
 		Symbol *sym;
 		Type **tpars;
 		Symbol **pars;
-	} d [NR_DECLARATORS];
+	} *d;
+};
+
+struct funpars {
+	int ntypes, nsyms;
+	int max;
+	Type **types;
+	Symbol **syms;
 };
 
 struct decl {
@@ -42,7 +49,12 @@ push(struct declarators *dp, int op, ...)
 
 	va_start(va, op);
 	if ((n = dp->nr++) == NR_DECLARATORS)
-		error("too much declarators");
+		pedwarn("more than %d declarators in a declaration",
+		        NR_DECLARATORS);
+	if (n == dp->max) {
+		dp->max = (n) ? 2*n : NR_DECLARATORS;
+		dp->d = xrealloc(dp->d, dp->max * sizeof(*dp->d));
+	}
 
 	p = &dp->d[n];
 	p->op = op;
@@ -84,7 +96,7 @@ pop(struct declarators *dp, struct decl *dcl)
 		 * function. We  don't need
 		 * the parameter symbols anymore.
 		 */
-		free(dcl->pars);
+		xfree(dcl->pars);
 		popctx();
 		dcl->pars = NULL;
 	}
@@ -109,7 +121,6 @@ arydcl(struct declarators *dp)
 				errorp("array size is not a positive number");
 				n = 1;
 			}
-			freetree(np);
 		}
 	}
 	expect(']');
@@ -201,12 +212,27 @@ static Symbol *dodcl(int rep,
                      unsigned ns,
                      Type *type);
 
+/*
+ * Make room for the parameter n in the arrays of types
+ * and symbols of a function declarator. syms has an
+ * additional element for the NULL terminator.
+ */
 static void
-krfun(Type *tp, Type *types[], Symbol *syms[], int *ntypes, int *nsyms)
+growpars(struct funpars *fp, int n)
+{
+	if (n < fp->max)
+		return;
+	fp->max = (fp->max) ? 2*fp->max : NR_FUNPARAM+1;
+	fp->types = xrealloctag(fp->types, fp->max * sizeof(Type *), MEM_TYPE);
+	fp->syms = xrealloctag(fp->syms, (fp->max+1) * sizeof(Symbol *),
+	                       MEM_SYMBOL);
+}
+
+static void
+krfun(Type *tp, struct funpars *fp)
 {
 	int n = 0;
 	Symbol *sym;
-	int toomany = 0;
 
 	if (yytoken != ')') {
 		do {
@@ -219,28 +245,26 @@ krfun(Type *tp, Type *types[], Symbol *syms[], int *ntypes, int *nsyms)
 				       sym->name);
 				continue;
 			}
-			if (n < NR_FUNPARAM) {
-				++n;
-				*syms++ = sym;
-				continue;
-			}
-			if (!toomany)
-				errorp("too much parameters in function definition");
-			toomany = 1;
+			if (n == NR_FUNPARAM)
+				pedwarn("more than %d parameters in function definition",
+				        NR_FUNPARAM);
+			growpars(fp, n);
+			fp->syms[n++] = sym;
 		} while (accept(','));
 	}
 
-	*nsyms = n;
-	*ntypes = 1;
-	types[0] = ellipsistype;
+	growpars(fp, 0);
+	fp->nsyms = n;
+	fp->ntypes = 1;
+	fp->types[0] = ellipsistype;
 }
 
 static void
-ansifun(Type *tp, Type *types[], Symbol *syms[], int *ntypes, int *nsyms)
+ansifun(Type *tp, struct funpars *fp)
 {
 	int n = 0;
 	Symbol *sym;
-	int toomany = 0, toovoid = 0;
+	int toovoid = 0;
 
 	do {
 		if (n == -1 && !toovoid) {
@@ -250,9 +274,12 @@ ansifun(Type *tp, Type *types[], Symbol *syms[], int *ntypes, int *nsyms)
 		if (accept(ELLIPSIS)) {
 			if (n == 0)
 				errorp("a named argument is requiered before '...'");
+			if (n >= 0) {
+				growpars(fp, n);
+				fp->syms[n] = NULL;
+				fp->types[n] = ellipsistype;
+			}
 			++n;
-			*syms = NULL;
-			*types++ = ellipsistype;
 			break;
 		}
 		if ((sym = dodcl(0, parameter, NS_IDEN, tp)) == NULL)
@@ -261,29 +288,25 @@ ansifun(Type *tp, Type *types[], Symbol *syms[], int *ntypes, int *nsyms)
 			n = -1;
 			continue;
 		}
-		if (n < NR_FUNPARAM) {
-			*syms++ = sym;
-			*types++ = sym->type;
-			++n;
-			continue;
-		}
-		if (!toomany)
-			errorp("too much parameters in function definition");
-		toomany = 1;
+		if (n == NR_FUNPARAM)
+			pedwarn("more than %d parameters in function definition",
+			        NR_FUNPARAM);
+		growpars(fp, n);
+		fp->syms[n] = sym;
+		fp->types[n++] = sym->type;
 	} while (accept(','));
 
-	*nsyms = n;
-	*ntypes = n;
+	fp->nsyms = n;
+	fp->ntypes = n;
 }
 
 static void
 fundcl(struct declarators *dp)
 {
-	Type *types[NR_FUNPARAM], type;
-	Symbol *syms[NR_FUNPARAM+1], **pars;
-	int k_r, ntypes, nsyms;
-	size_t size;
-	void (*fp)(Type **, Symbol **, int *, int *);
+	Type type;
+	Symbol **pars;
+	struct funpars fp = {.max = 0, .types = NULL, .syms = NULL};
+	int k_r, n;
 
 	pushctx();
 	expect('(');
@@ -291,22 +314,22 @@ fundcl(struct declarators *dp)
 	type.k_r = 0;
 
 	k_r = (yytoken == ')' || yytoken == IDEN);
-	(*(k_r ? krfun : ansifun))(&type, types, syms, &ntypes, &nsyms);
+	(*(k_r ? krfun : ansifun))(&type, &fp);
 	expect(')');
 
-	type.n.elem = ntypes;
-	if (ntypes <= 0) {
+	type.n.elem = n = fp.ntypes;
+	if (n <= 0) {
+		xfree(fp.types);
 		type.p.pars = NULL;
 	} else {
-		size = ntypes * sizeof(Type *);
-		type.p.pars = memcpy(xmalloc(size), types, size);
+		type.p.pars = xrealloc(fp.types, n * sizeof(Type *));
 	}
-	if (nsyms <= 0) {
+	if ((n = fp.nsyms) <= 0) {
+		xfree(fp.syms);
 		pars = NULL;
 	} else {
-		size = (nsyms + 1) * sizeof(Symbol *);
-		pars = memcpy(xmalloc(size), syms, size);
-		pars[nsyms] = NULL;
+		pars = xrealloc(fp.syms, (n + 1) * sizeof(Symbol *));
+		pars[n] = NULL;
 	}
 	push(dp, (k_r) ? KRFTN : FTN, type.n.elem, type.p.pars, pars);
 }
@@ -321,7 +344,8 @@ directdcl(struct declarators *dp, unsigned ns)
 
 	if (accept('(')) {
 		if (nested == NR_SUBTYPE)
-			error("too declarators nested by parentheses");
+			pedwarn("more than %d declarators nested by parentheses",
+			        NR_SUBTYPE);
 		++nested;
 		declarator(dp, ns);
 		--nested;
@@ -525,13 +549,15 @@ structdcl(void)
 	tp->defined = 1;
 
 	if (nested == NR_STRUCT_LEVEL)
-		error("too levels of nested structure or union definitions");
+		pedwarn("more than %d levels of nested structure or union definitions",
+		        NR_STRUCT_LEVEL);
 
 	++nested;
 	while (yytoken != '}') {
 		fieldlist(tp);
 	}
 	--nested;
+	tp->size = typesize(tp);
 
 	namespace = ns;
 	expect('}');
@@ -543,7 +569,7 @@ enumdcl(void)
 {
 	Type *tp;
 	Symbol *sym, *tagsym;
-	int ns, val, toomany;
+	int ns, val;
 	unsigned nctes;
 
 	ns = namespace;
@@ -563,10 +589,9 @@ enumdcl(void)
 			unexpected();
 		sym = yylval.sym;
 		next();
-		if (nctes == NR_ENUM_CTES && !toomany) {
-			errorp("too many enum constants in a single enum");
-			toomany = 1;
-		}
+		if (nctes == NR_ENUM_CTES)
+			pedwarn("more than %d enumeration constants in a single enum",
+			        NR_ENUM_CTES);
 		if (accept('=')) {
 			Node *np = iconstexpr();
 
@@ -574,7 +599,6 @@ enumdcl(void)
 				errorp("invalid enumeration value");
 			else
 				val = np->sym->u.i;
-			freetree(np);
 		}
 		if ((sym = install(NS_IDEN, sym)) == NULL) {
 			errorp("'%s' redeclared as different kind of symbol",
@@ -631,11 +655,18 @@ field(struct decl *dcl)
 
 	sym->flags |= ISFIELD;
 	if (n == NR_FIELDS)
-		error("too much fields in struct/union");
+		pedwarn("more than %d members in a struct/union", NR_FIELDS);
 	DBG("New field '%s' in namespace %d\n", name, structp->ns);
-	structp->p.fields = xrealloc(structp->p.fields, ++n * sizeof(*sym));
-	structp->p.fields[n-1] = sym;
+	/* the array of fields doubles its size every power of 2 */
+	if ((n & n-1) == 0) {
+		structp->p.fields = xrealloctag(structp->p.fields,
+		                                (n ? 2*n : 1) * sizeof(Symbol *),
+		                                MEM_TYPE);
+	}
+	structp->p.fields[n++] = sym;
 	structp->n.elem = n;
+	if (tp->align > structp->align)
+		structp->align = tp->align;
 
 	return sym;
 }
@@ -798,6 +829,8 @@ dodcl(int rep, Symbol *(*fun)(struct decl *), unsigned ns, Type *parent)
 	dcl.ns = ns;
 	dcl.parent = parent;
 	base = specifier(&dcl.sclass, &dcl.qualifier);
+	stack.max = 0;
+	stack.d = NULL;
 
 	do {
 		stack.nr = 0;
@@ -810,6 +843,7 @@ dodcl(int rep, Symbol *(*fun)(struct decl *), unsigned ns, Type *parent)
 			/* nothing */;
 		sym = (*fun)(&dcl);
 	} while (rep && accept(','));
+	xfree(stack.d);
 
 	return sym;
 }
@@ -844,7 +878,7 @@ decl(void)
 			(*p)->flags |= ISUSED;
 		popctx();
 		expect(';');
-		free(sym->u.pars);
+		xfree(sym->u.pars);
 		sym->u.pars = NULL;
 		curfun = ocurfun;
 		return;
@@ -26,7 +26,9 @@ warn_error(int flag, char *fmt, va_list va)
 	if (flag < 0) {
 		if (!failure) {
 			failure = 1;
-			fclose(stdout);
+			flushout();
+			if (!irfun)
+				fclose(stdout);
 		}
 		failure = 1;
 		if (nerrors++ == MAXERRNUM) {
@@ -47,6 +49,17 @@ warn(char *fmt, ...)
 	va_end(va);
 }
 
+void
+pedwarn(char *fmt, ...)
+{
+	extern int pedantic;
+
+	va_list va;
+	va_start(va, fmt);
+	warn_error(pedantic, fmt, va);
+	va_end(va);
+}
+
 void
 error(char *fmt, ...)
 {
@@ -183,8 +183,6 @@ chkternary(Node *yes, Node *no)
 
 wrong_type:
 	errorp("type mismatch in conditional expression");
-	freetree(yes);
-	freetree(no);
 	return constnode(zero);
 }
 
@@ -207,7 +205,6 @@ decay(Node *np)
 		tp = tp->type;
 		if (np->op == OPTR) {
 			Node *new = np->left;
-			free(np);
 			new->type = mktype(tp, PTR, 0, NULL);
 			return new;
 		}
@@ -389,8 +386,6 @@ compare(char op, Node *lp, Node *rp)
 		return simplify(op, inttype, lp, rp);
 	} else {
 		errorp("incompatibles type in comparision");
-		freetree(lp);
-		freetree(rp);
 		return constnode(zero);
 	}
 }
@@ -456,19 +451,15 @@ field(Node *np)
 	if (!np->type->aggreg) {
 		errorp("request for member '%s' in something not a structure or union",
 		      yylval.sym->name);
-		goto free_np;
+		return constnode(zero);
 	}
 	if ((sym->flags & ISDECLARED) == 0) {
 		errorp("incorrect field in struct/union");
-		goto free_np;
+		return constnode(zero);
 	}
 	np = node(OFIELD, sym->type, np, varnode(sym));
 	np->lvalue = 1;
 	return np;
-
-free_np:
-	freetree(np);
-	return constnode(zero);
 }
 
 static Node *
@@ -482,7 +473,6 @@ content(char op, Node *np)
 		if (np->op == OADDR) {
 			Node *new = np->left;
 			new->type = np->type->type;
-			free(np);
 			np = new;
 		} else {
 			np = node(op, np->type->type, np, NULL);
@@ -551,11 +541,8 @@ address(char op, Node *np)
 		chklvalue(np);
 		if (np->symbol && (np->sym->flags & ISREGISTER))
 			errorp("address of register variable '%s' requested", yytext);
-		if (np->op == OPTR) {
-			Node *new = np->left;
-			free(np);
-			return new;
-		}
+		if (np->op == OPTR)
+			return np->left;
 	}
 	return node(op, mktype(np->type, PTR, 0, NULL), np, NULL);
 }
@@ -566,7 +553,6 @@ negation(char op, Node *np)
 	np = decay(np);
 	if (!np->type->arith && np->type->op != PTR) {
 		errorp("invalid argument of unary '!'");
-		freetree(np);
 		return constnode(zero);
 	}
 	return exp2cond(np, 1);
@@ -738,13 +724,9 @@ static Node *unary(void);
 static Type *
 typeof(Node *np)
 {
-	Type *tp;
-
 	if (np == NULL)
 		unexpected();
-	tp = np->type;
-	freetree(np);
-	return tp;
+	return np->type;
 }
 
 static Type *
@@ -829,7 +811,8 @@ cast(void)
 		break;
 	default:
 		if (nested == NR_SUBEXPR)
-			error("too expressions nested by parentheses");
+			pedwarn("more than %d expressions nested by parentheses",
+			        NR_SUBEXPR);
 		++nested;
 		rp = expr();
 		--nested;
@@ -841,151 +824,50 @@ cast(void)
 	return rp;
 }
 
-static Node *
-mul(void)
-{
-	Node *np, *(*fun)(char, Node *, Node *);
-	char op;
-
-	np = cast();
-	for (;;) {
-		switch (yytoken) {
-		case '*': op = OMUL; fun = arithmetic; break;
-		case '/': op = ODIV; fun = arithmetic; break;
-		case '%': op = OMOD; fun = integerop;  break;
-		default: return np;
-		}
-		next();
-		np = (*fun)(op, np, cast());
-	}
-}
-
-static Node *
-add(void)
-{
-	char op;
-	Node *np;
-
-	np = mul();
-	for (;;) {
-		switch (yytoken) {
-		case '+': op = OADD; break;
-		case '-': op = OSUB; break;
-		default:  return np;
-		}
-		next();
-		np = arithmetic(op, np, mul());
-	}
-}
-
-static Node *
-shift(void)
-{
-	char op;
-	Node *np;
-
-	np = add();
-	for (;;) {
-		switch (yytoken) {
-		case SHL: op = OSHL; break;
-		case SHR: op = OSHR; break;
-		default:  return np;
-		}
-		next();
-		np = integerop(op, np, add());
-	}
-}
-
-static Node *
-relational(void)
-{
+/*
+ * Binary operators from multiplicative to logical or, indexed by
+ * token. All of them are left associative, so they are parsed by
+ * precedence climbing: an operand is extended while the next token
+ * is an operator with at least the requested precedence, and the
+ * right operand only takes operators binding tighter than it.
+ * Precedence 0 means that the token is not a binary operator.
+ */
+static struct binop {
+	unsigned char prec;
 	char op;
-	Node *np;
-
-	np = shift();
-	for (;;) {
-		switch (yytoken) {
-		case '<': op = OLT; break;
-		case '>': op = OGT; break;
-		case GE:  op = OGE; break;
-		case LE:  op = OLE; break;
-		default:  return np;
-		}
-		next();
-		np = compare(op, np, shift());
-	}
-}
+	Node *(*fun)(char, Node *, Node *);
+} binops[OR+1] = {
+	['*'] = {10, OMUL,  arithmetic},
+	['/'] = {10, ODIV,  arithmetic},
+	['%'] = {10, OMOD,  integerop},
+	['+'] = {9,  OADD,  arithmetic},
+	['-'] = {9,  OSUB,  arithmetic},
+	[SHL] = {8,  OSHL,  integerop},
+	[SHR] = {8,  OSHR,  integerop},
+	['<'] = {7,  OLT,   compare},
+	['>'] = {7,  OGT,   compare},
+	[GE]  = {7,  OGE,   compare},
+	[LE]  = {7,  OLE,   compare},
+	[EQ]  = {6,  OEQ,   compare},
+	[NE]  = {6,  ONE,   compare},
+	['&'] = {5,  OBAND, integerop},
+	['^'] = {4,  OBXOR, integerop},
+	['|'] = {3,  OBOR,  integerop},
+	[AND] = {2,  OAND,  logic},
+	[OR]  = {1,  OOR,   logic}
+};
 
 static Node *
-eq(void)
+binary(int prec)
 {
-	char op;
+	struct binop *bp;
 	Node *np;
 
-	np = relational();
-	for (;;) {
-		switch (yytoken) {
-		case EQ: op = OEQ; break;
-		case NE: op = ONE; break;
-		default: return np;
-		}
+	np = cast();
+	while (yytoken <= OR && (bp = &binops[yytoken])->prec >= prec) {
 		next();
-		np = compare(op, np, relational());
+		np = (*bp->fun)(bp->op, np, binary(bp->prec + 1));
 	}
-}
-
-static Node *
-bit_and(void)
-{
-	Node *np;
-
-	np = eq();
-	while (accept('&'))
-		np = integerop(OBAND, np, eq());
-	return np;
-}
-
-static Node *
-bit_xor(void)
-{
-	Node *np;
-
-	np = bit_and();
-	while (accept('^'))
-		np = integerop(OBXOR,  np, bit_and());
-	return np;
-}
-
-static Node *
-bit_or(void)
-{
-	Node *np;
-
-	np = bit_xor();
-	while (accept('|'))
-		np = integerop(OBOR, np, bit_xor());
-	return np;
-}
-
-static Node *
-and(void)
-{
-	Node *np;
-
-	np = bit_or();
-	while (accept(AND))
-		np = logic(OAND, np, bit_or());
-	return np;
-}
-
-static Node *
-or(void)
-{
-	Node *np;
-
-	np = and();
-	while (accept(OR))
-		np = logic(OOR, np, and());
 	return np;
 }
 
@@ -994,7 +876,7 @@ ternary(void)
 {
 	Node *cond;
 
-	cond = or();
+	cond = binary(1);
 	while (accept('?')) {
 		Node *ifyes, *ifno, *np;
 
@@ -1042,10 +924,8 @@ constexpr(void)
 	Node *np;
 
 	np = ternary();
-	if (!np->constant) {
-		freetree(np);
+	if (!np->constant)
 		return NULL;
-	}
 	return np;
 }
 
@@ -1057,10 +937,8 @@ iconstexpr(void)
 	if ((np = constexpr()) == NULL)
 		return NULL;
 
-	if (np->type->op != INT) {
-		freetree(np);
+	if (np->type->op != INT)
 		return NULL;
-	}
 
 	return convert(np, inttype, 0);
 }
@@ -1106,7 +984,6 @@ arydesig(Type *tp)
 	next();
 	np = iconstexpr();
 	npos = np->sym->u.i;
-	freetree(np);
 	expect(']');
 	return npos;
 }
@@ -1259,6 +1136,6 @@ initializer(Symbol *sym, Type *tp, int nelem)
 		       sym->name, (flags&ISEXTERN) ? "extern" : "typedef");
 	} else {
 		np->op = OASSIGN;
-		emit(OEXPR, np);
+		emit(OEXPR, cse(np));
 	}
 }
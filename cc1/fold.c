@@ -335,8 +335,6 @@ fold(int op, Type *tp, Node *lp, Node *rp)
 		return NULL;
 	}
 
-	freetree(lp);
-	freetree(rp);
 	return np;
 }
 
@@ -395,9 +393,9 @@ identity(int *op, Node *lp, Node *rp)
 		 * i || 1 => i,1  (comma)
 		 */
 		if (isonel | iszeror)
-			goto free_right;
+			goto drop_right;
 		if (iszerol)
-			goto free_left;
+			goto drop_left;
 		if (isoner)
 			goto change_to_comma;
 		return NULL;
@@ -409,9 +407,9 @@ identity(int *op, Node *lp, Node *rp)
 		 * i && 0 => i,0  (comma)
 		 */
 		if (iszerol | isoner)
-			goto free_right;
+			goto drop_right;
 		if (isonel)
-			goto free_left;
+			goto drop_left;
 		if (iszeror)
 			goto change_to_comma;
 		return NULL;
@@ -424,7 +422,7 @@ identity(int *op, Node *lp, Node *rp)
 		 * 0 << i => 0    (free right)
 		 */
 		if (iszeror | iszerol)
-			goto free_right;
+			goto drop_right;
 		return NULL;
 	case OBXOR:
 	case OADD:
@@ -437,7 +435,7 @@ identity(int *op, Node *lp, Node *rp)
 		 * i ^ 0  => i
 		 */
 		if (iszeror)
-			goto free_right;
+			goto drop_right;
 		return NULL;
 	case OMUL:
 		/*
@@ -447,17 +445,17 @@ identity(int *op, Node *lp, Node *rp)
 		if (iszeror)
 			goto change_to_comma;
 		if (isoner)
-			goto free_right;
+			goto drop_right;
 		return NULL;
 	case ODIV:
 		/* i / 1  => i */
 		if (isoner)
-			goto free_right;
+			goto drop_right;
 		return NULL;
 	case OBAND:
 		/* i & ~0 => i */
 		if (cmpnode(rp, -1))
-			goto free_right;
+			goto drop_right;
 		return NULL;
 	case OMOD:
 		/* i % 1  => i,1 */
@@ -467,12 +465,10 @@ identity(int *op, Node *lp, Node *rp)
 		return NULL;
 	}
 
-free_right:
-	freetree(rp);
+drop_right:
 	return lp;
 
-free_left:
-	freetree(lp);
+drop_left:
 	return rp;
 
 change_to_comma:
@@ -483,27 +479,240 @@ change_to_comma:
 static Node *
 foldternary(int op, Type *tp, Node *cond, Node *body)
 {
-	Node *np;
-
 	if (!cond->constant)
 		return node(op, tp, cond, body);
-	if (cmpnode(cond, 0)) {
-		np = body->right;
-		freetree(body->left);
-	} else {
-		np = body->left;
-		freetree(body->right);
+	if (cmpnode(cond, 0))
+		return body->right;
+	return body->left;
+}
+
+static Node *
+intconst(Type *tp, TUINT u)
+{
+	Symbol *sym;
+
+	sym = newsym(NS_IDEN);
+	sym->type = tp;
+	sym->u.u = u;
+	return constnode(sym);
+}
+
+/*
+ * Combine two integer constants of type tp without checking
+ * overflows, wrapping around in the same way that the target does
+ */
+static Node *
+wrapconst(int op, Type *tp, Node *lp, Node *rp)
+{
+	TUINT u, mask, l = lp->sym->u.u, r = rp->sym->u.u;
+
+	switch (op) {
+	case OADD:  u = l + r; break;
+	case OSUB:  u = l - r; break;
+	case OMUL:  u = l * r; break;
+	case OBAND: u = l & r; break;
+	case OBXOR: u = l ^ r; break;
+	case OBOR:  u = l | r; break;
+	default:    abort();
 	}
-	freetree(cond);
-	free(body);
-	return np;
+	mask = ones(tp->size);
+	u &= mask;
+	if (tp->sign && (u & ~(mask >> 1)))
+		u |= ~mask;
+	return intconst(tp, u);
+}
+
+static bool
+isassoc(int op)
+{
+	switch (op) {
+	case OADD:
+	case OMUL:
+	case OBAND:
+	case OBXOR:
+	case OBOR:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+/* the two shifts together are smaller than the width of the type */
+static bool
+shiftsum(Type *tp, Node *lp, Node *rp)
+{
+	TUINT l = lp->sym->u.u, r = rp->sym->u.u, bits = tp->size * 8;
+
+	return l < bits && r < bits && l + r < bits;
+}
+
+static bool
+isconstop(Node *np, Type *tp)
+{
+	return np->type == tp && np->right && np->right->constant;
 }
 
 /*
- * TODO: transform simplify in a recursivity
- * function, because we are losing optimization
- * chances
+ * Reassociate integer expressions moving the constants to the
+ * top of the tree, where they meet and can be folded:
+ *
+ * (a op c1) op c2 => a op (c1 op c2)
+ * (a op c) op b   => (a op b) op c
+ * a op (b op c)   => (a op b) op c
+ * (a +- c1) +- c2 => a +- (c1 +- c2)
+ * (a +- c1) * c2   => a * c2 +- c1 * c2
+ * (a << c1) << c2 => a << (c1 + c2)
+ *
+ * The new nodes are built with simplify(), so the transformation
+ * is applied again until there is nothing left to combine.
  */
+static Node *
+reassoc(int op, Type *tp, Node *lp, Node *rp)
+{
+	Node *np;
+	int lop = lp->op;
+
+	if (tp->op != INT && tp->op != PTR)
+		return NULL;
+	if (!rp || lp->type != tp || rp->type != tp)
+		return NULL;
+
+	if (rp->constant) {
+		if (!isconstop(lp, tp))
+			return NULL;
+		if (lop == op && isassoc(op)) {
+			rp = wrapconst(op, tp, lp->right, rp);
+			return simplify(op, tp, lp->left, rp);
+		}
+		if ((op == OADD || op == OSUB) && (lop == OADD || lop == OSUB)) {
+			rp = wrapconst((lop == op) ? OADD : OSUB, tp, lp->right, rp);
+			/* a + -c => a - c */
+			if (tp->sign && rp->sym->u.i < 0) {
+				rp = wrapconst(OSUB, tp, constnode(zero), rp);
+				lop = (lop == OADD) ? OSUB : OADD;
+			}
+			return simplify(lop, tp, lp->left, rp);
+		}
+		if ((op == OSHL || op == OSHR) && lop == op) {
+			if (!shiftsum(tp, lp->right, rp))
+				return NULL;
+			rp = wrapconst(OADD, tp, lp->right, rp);
+			return simplify(op, tp, lp->left, rp);
+		}
+		if (op == OMUL && (lop == OADD || lop == OSUB)) {
+			np = wrapconst(OMUL, tp, lp->right, rp);
+			lp = simplify(OMUL, tp, lp->left, rp);
+			return simplify(lop, tp, lp, np);
+		}
+		return NULL;
+	}
+
+	if (!isassoc(op))
+		return NULL;
+	if (lop == op && isconstop(lp, tp)) {
+		np = lp->right;
+		lp = simplify(op, tp, lp->left, rp);
+		return simplify(op, tp, lp, np);
+	}
+	if (rp->op == op && isconstop(rp, tp)) {
+		np = rp->right;
+		lp = simplify(op, tp, lp, rp->left);
+		return simplify(op, tp, lp, np);
+	}
+	return NULL;
+}
+
+/*
+ * Return n if u is 2^n, or -1 otherwise
+ */
+static int
+ilog2(TUINT u)
+{
+	int n;
+
+	if (u == 0 || (u & u-1) != 0)
+		return -1;
+	for (n = 0; u >>= 1; ++n)
+		/* nothing */;
+	return n;
+}
+
+static Node *
+dupnode(Node *np)
+{
+	Node *new = node(np->op, np->type, NULL, NULL);
+
+	*new = *np;
+	return new;
+}
+
+/*
+ * Strength reduction of multiplications, divisions and modulos
+ * by constants, which otherwise are calls to runtime functions:
+ *
+ * i * 2^n => i << n
+ * i * (2^n + 2^m) => (i << n) + (i << m)
+ * i * (2^n - 1) => (i << n) - i
+ * u / 2^n => u >> n
+ * u % 2^n => u & 2^n-1
+ * i / 2^n => (i + (i >> bits-1 & 2^n-1)) >> n
+ *
+ * The rules that use the operand twice are only applied
+ * when it is a variable, and the shifts are always smaller
+ * than the width of the type.
+ */
+static Node *
+strength(int op, Type *tp, Node *lp, Node *rp)
+{
+	TUINT c, low;
+	int n, m, isvar, bits = tp->size * 8;
+
+	if (tp->op != INT || !rp || !rp->constant || lp->type != tp)
+		return NULL;
+	if (tp->sign && rp->sym->u.i <= 0)
+		return NULL;
+	c = rp->sym->u.u;
+	n = ilog2(c);
+	isvar = lp->op == OSYM && !lp->constant;
+
+	switch (op) {
+	case OMUL:
+		if (n > 0)
+			return simplify(OSHL, tp, lp, intconst(tp, n));
+		if (!isvar)
+			return NULL;
+		low = c & -c;
+		if ((m = ilog2(c - low)) > 0 && m < bits) {
+			n = ilog2(low);
+			rp = simplify(OSHL, tp, lp, intconst(tp, m));
+			lp = simplify(OSHL, tp, dupnode(lp), intconst(tp, n));
+			return simplify(OADD, tp, rp, lp);
+		}
+		if ((m = ilog2(c + 1)) > 0 && m < bits) {
+			rp = simplify(OSHL, tp, lp, intconst(tp, m));
+			return simplify(OSUB, tp, rp, dupnode(lp));
+		}
+		return NULL;
+	case ODIV:
+		if (n <= 0)
+			return NULL;
+		if (!tp->sign)
+			return simplify(OSHR, tp, lp, intconst(tp, n));
+		if (!isvar)
+			return NULL;
+		rp = simplify(OSHR, tp, dupnode(lp), intconst(tp, tp->size*8 - 1));
+		rp = simplify(OBAND, tp, rp, intconst(tp, ((TUINT) 1 << n) - 1));
+		lp = simplify(OADD, tp, lp, rp);
+		return simplify(OSHR, tp, lp, intconst(tp, n));
+	case OMOD:
+		if (n <= 0 || tp->sign)
+			return NULL;
+		return simplify(OBAND, tp, lp, intconst(tp, ((TUINT) 1 << n) - 1));
+	default:
+		return NULL;
+	}
+}
+
 Node *
 simplify(int op, Type *tp, Node *lp, Node *rp)
 {
@@ -516,6 +725,10 @@ simplify(int op, Type *tp, Node *lp, Node *rp)
 		return np;
 	if ((np = identity(&op, lp, rp)) != NULL)
 		return np;
+	if ((np = reassoc(op, tp, lp, rp)) != NULL)
+		return np;
+	if ((np = strength(op, tp, lp, rp)) != NULL)
+		return np;
 	return node(op, tp, lp, rp);
 }
 
@@ -525,6 +738,7 @@ Node *
 castcode(Node *np, Type *newtp)
 {
 	TUINT negmask, mask, u;
+	int op;
 	Type *oldtp = np->type;
 	Symbol aux, *sym, *osym = np->sym;
 
@@ -574,5 +788,22 @@ castcode(Node *np, Type *newtp)
 	return np;
 
 noconstant:
+	/*
+	 * (tp) (a +- c) => (tp) a +- (tp) c
+	 * (tp) (a * c) => (tp) a * (tp) c
+	 * if the size does not change
+	 */
+	op = np->op;
+	if (oldtp->size != newtp->size || !np->right || !np->right->constant)
+		goto cast;
+	if (oldtp->op != INT && oldtp->op != PTR)
+		goto cast;
+	if (op == OMUL && newtp->op == INT ||
+	    (op == OADD || op == OSUB) && (newtp->op == INT || newtp->op == PTR)) {
+		return simplify(op, newtp,
+		                castcode(np->left, newtp),
+		                castcode(np->right, newtp));
+	}
+cast:
 	return node(OCAST, newtp, np, NULL);
 }
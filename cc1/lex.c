@@ -27,9 +27,9 @@ allocinput(char *fname, FILE *fp)
 {
 	Input *ip;
 
-	ip = xmalloc(sizeof(Input));
+	ip = xmalloctag(sizeof(Input), MEM_INPUT);
 	ip->fname = xstrdup(fname);
-	ip->p = ip->begin = ip->line = xmalloc(INPUTSIZ);
+	ip->p = ip->begin = ip->line = xmalloctag(INPUTSIZ, MEM_INPUT);
 	ip->nline = 0;
 	ip->next = input;
 	ip->fp = fp;
@@ -116,8 +116,8 @@ delinput(void)
 	if (eof)
 		return;
 	input = ip->next;
-	free(ip->fname);
-	free(ip->line);
+	xfree(ip->fname);
+	xfree(ip->line);
 }
 
 static void
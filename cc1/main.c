@@ -9,11 +9,12 @@
 #include "../inc/cc.h"
 #include "cc1.h"
 
-int warnings;
+int warnings, pedantic;
 jmp_buf recover;
 
 static char *output, *arg0;
 int onlycpp;
+static int stats, fbin;
 
 static void
 clean(void)
@@ -28,7 +29,8 @@ static void
 usage(void)
 {
 	fprintf(stderr,
-	        "usage: %s [-E] [-Dmacro[=value]] [-Idir] [-w] [-d] [-o output] [input]\n",
+	        "usage: %s [-E] [-Dmacro[=value]] [-Idir] [-w] [-d] [-stats] "
+	        "[-pedantic] [-Fbin] [-o output] [input]\n",
 	        arg0);
 	exit(1);
 }
@@ -39,6 +41,7 @@ main(int argc, char *argv[])
 	char c, *cp;
 
 	atexit(clean);
+	atexit(memstats);
 
 	arg0 = (cp = strrchr(*argv, '/')) ? cp+1 : *argv;
 	if (!strcmp(arg0, "cpp"))
@@ -66,6 +69,21 @@ main(int argc, char *argv[])
 			case 'I':
 				incdir(cp+1);
 				goto nextiter;
+			case 's':
+				if (strcmp(cp, "stats"))
+					usage();
+				stats = 1;
+				goto nextiter;
+			case 'p':
+				if (strcmp(cp, "pedantic"))
+					usage();
+				pedantic = 1;
+				goto nextiter;
+			case 'F':
+				if (strcmp(cp, "Fbin"))
+					usage();
+				fbin = 1;
+				goto nextiter;
 			case 'o':
 				if (!*++argv || argv[0][0] == '-')
 					usage();
@@ -89,9 +107,16 @@ main(int argc, char *argv[])
 	if (onlycpp) {
 		outcpp();
 	} else {
-		for (next(); yytoken != EOFTOK; decl())
-			/* nothing */;
+		if (fbin)
+			binaryir();
+		for (next(); yytoken != EOFTOK; freenodes(0))
+			decl();
+		flushout();
 	}
 
+	if (stats) {
+		symstats();
+		typestats();
+	}
 	return 0;
 }
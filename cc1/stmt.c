@@ -45,7 +45,7 @@ stmtexp(Symbol *lbreak, Symbol *lcont, Caselist *lswitch)
 		stmt(lbreak, lcont, lswitch);
 		return;
 	}
-	emit(OEXPR, expr());
+	emit(OEXPR, cse(expr()));
 	expect(';');
 }
 
@@ -78,6 +78,7 @@ While(Symbol *lbreak, Symbol *lcont, Caselist *lswitch)
 	emit(OLABEL, begin);
 	stmt(end, begin, lswitch);
 	emit(OLABEL, cond);
+	np = cse(np);
 	emit(OBRANCH, begin);
 	emit(OEXPR, np);
 	emit(OELOOP, NULL);
@@ -103,13 +104,14 @@ For(Symbol *lbreak, Symbol *lcont, Caselist *lswitch)
 	einc = (yytoken != ')') ? expr() : NULL;
 	expect(')');
 
-	emit(OEXPR, einit);
+	emit(OEXPR, cse(einit));
 	emit(OJUMP, cond);
 	emit(OBLOOP, NULL);
 	emit(OLABEL, begin);
 	stmt(end, begin, lswitch);
-	emit(OEXPR, einc);
+	emit(OEXPR, cse(einc));
 	emit(OLABEL, cond);
+	econd = cse(econd);
 	emit(OBRANCH, begin);
 	emit(OEXPR, econd);
 	emit(OELOOP, NULL);
@@ -129,7 +131,7 @@ Dowhile(Symbol *lbreak, Symbol *lcont, Caselist *lswitch)
 	emit(OLABEL, begin);
 	stmt(end, begin, lswitch);
 	expect(WHILE);
-	np = condition();
+	np = cse(condition());
 	emit(OBRANCH, begin);
 	emit(OEXPR, np);
 	emit(OELOOP, NULL);
@@ -155,6 +157,7 @@ Return(Symbol *lbreak, Symbol *lcont, Caselist *lswitch)
 		else if ((np = convert(np, tp, 0)) == NULL)
 			error("incorrect type in return");
 	}
+	np = cse(np);
 	emit(ORET, NULL);
 	emit(OEXPR, np);
 }
@@ -218,7 +221,7 @@ Switch(Symbol *lbreak, Symbol *lcont, Caselist *lswitch)
 	}
 	expect (')');
 
-	lcase.expr = cond;
+	lcase.expr = cse(cond);
 	lcase.lbreak = newlabel();
 	lcase.ltable = newlabel();
 
@@ -242,17 +245,15 @@ Case(Symbol *lbreak, Symbol *lcont, Caselist *lswitch)
 	if ((np = iconstexpr()) == NULL)
 		errorp("case label does not reduce to an integer constant");
 	expect(':');
-	if (lswitch && lswitch->nr >= 0) {
-		if (++lswitch->nr == NR_SWITCH) {
-			errorp("too case labels for a switch statement");
-			lswitch->nr = -1;
-		} else {
-			pcase = xmalloc(sizeof(*pcase));
-			pcase->expr = np;
-			pcase->next = lswitch->head;
-			emit(OLABEL, pcase->label = newlabel());
-			lswitch->head = pcase;
-		}
+	if (lswitch) {
+		if (++lswitch->nr == NR_SWITCH+1)
+			pedwarn("more than %d case labels in a switch statement",
+			        NR_SWITCH);
+		pcase = xmalloc(sizeof(*pcase));
+		pcase->expr = np;
+		pcase->next = lswitch->head;
+		emit(OLABEL, pcase->label = newlabel());
+		lswitch->head = pcase;
 	}
 	stmt(lbreak, lcont, lswitch);
 }
@@ -278,9 +279,9 @@ If(Symbol *lbreak, Symbol *lcont, Caselist *lswitch)
 
 	lelse = newlabel();
 	expect(IF);
-	np = condition();
+	np = cse(negate(condition()));
 	emit(OBRANCH, lelse);
-	emit(OEXPR, negate(np));
+	emit(OEXPR, np);
 	stmt(lbreak, lcont, lswitch);
 	if (accept(ELSE)) {
 		end = newlabel();
@@ -316,18 +317,27 @@ void
 compound(Symbol *lbreak, Symbol *lcont, Caselist *lswitch)
 {
 	static int nested;
+	unsigned mark;
 
 	pushctx();
 	expect('{');
 
 	if (nested == NR_BLOCK)
-		error("too nesting levels of compound statements");
+		pedwarn("more than %d nesting levels of compound statements",
+		        NR_BLOCK);
 
 	++nested;
 	for (;;) {
 		if (yytoken == '}')
 			break;
+		/*
+		 * case expressions are emitted at the end of the
+		 * switch, so nodes are not freed inside of it
+		 */
+		mark = marknodes();
 		blockit(lbreak, lcont, lswitch);
+		if (!lswitch)
+			freenodes(mark);
 	}
 	--nested;
 
@@ -10,13 +10,20 @@
 #include "cc1.h"
 
 #define NR_SYM_HASH 64
+#define NR_STATNS (NS_STRUCTS+1)
 
 unsigned curctx;
-static unsigned short counterid;
+static unsigned counterid;
 
 static Symbol *head, *labels;
 static Symbol *htab[NR_SYM_HASH];
 
+static struct {
+	unsigned long lookups[NR_STATNS], hits[NR_STATNS];
+	unsigned long probes, maxprobes;
+	unsigned long alloc, freed, live, peak;
+} stats;
+
 #ifndef NDEBUG
 void
 dumpstab(char *msg)
@@ -29,13 +36,13 @@ dumpstab(char *msg)
 			continue;
 		fprintf(stderr, "%d", (int) (bp - htab));
 		for (sym = *bp; sym; sym = sym->hash)
-			fprintf(stderr, "->[%d,%d:'%s'=%p]",
+			fprintf(stderr, "->[%d,%u:'%s'=%p]",
 			        sym->ns, sym->ctx, sym->name, (void *) sym);
 		putc('\n', stderr);
 	}
 	fputs("head:", stderr);
 	for (sym = head; sym; sym = sym->next) {
-		fprintf(stderr, "->[%d,%d:'%s'=%p]",
+		fprintf(stderr, "->[%d,%u:'%s'=%p]",
 		        sym->ns, sym->ctx,
 		        (sym->name) ? sym->name : "", (void *) sym);
 	}
@@ -43,14 +50,57 @@ dumpstab(char *msg)
 }
 #endif
 
+void
+symstats(void)
+{
+	static char *names[NR_STATNS] = {
+		[NS_IDEN] = "identifiers",
+		[NS_TAG] = "tags",
+		[NS_LABEL] = "labels",
+		[NS_CPP] = "macros",
+		[NS_KEYWORD] = "keywords",
+		[NS_CPPCLAUSES] = "directives",
+		[NS_STRUCTS] = "fields"
+	};
+	unsigned long n, total = 0;
+	int ns;
+
+	fputs("symbol table lookups:\n", stderr);
+	for (ns = NS_IDEN; ns < NR_STATNS; ++ns) {
+		if ((n = stats.lookups[ns]) == 0)
+			continue;
+		total += n;
+		fprintf(stderr, "\t%-12s %8lu lookups %8lu hits (%.1f%%)\n",
+		        names[ns], n, stats.hits[ns],
+		        100.0 * stats.hits[ns] / n);
+	}
+	fprintf(stderr, "hash chains: %.2f average, %lu maximum probes\n",
+	        (total) ? (double) stats.probes / total : 0.0,
+	        stats.maxprobes);
+	fprintf(stderr, "symbols: %lu allocated, %lu freed, %lu peak live\n",
+	        stats.alloc, stats.freed, stats.peak);
+}
+
+static void
+countlookup(int ns, unsigned long probes, int hit)
+{
+	if (ns > NS_STRUCTS)
+		ns = NS_STRUCTS;
+	++stats.lookups[ns];
+	stats.hits[ns] += hit;
+	stats.probes += probes;
+	if (probes > stats.maxprobes)
+		stats.maxprobes = probes;
+}
+
 static unsigned
 hash(const char *s)
 {
 	unsigned c, h;
 
-	for (h = 0; c = *s; ++s)
-		h ^= 33 * c;
-	return h & NR_SYM_HASH-1;
+	for (h = 5381; c = *s; ++s)
+		h = h*33 ^ c;
+	return h;
 }
 
 static void
@@ -60,7 +110,7 @@ unlinkhash(Symbol *sym)
 
 	if ((sym->flags & ISDECLARED) == 0)
 		return;
-	h = &htab[hash(sym->name)];
+	h = &htab[sym->hval & NR_SYM_HASH-1];
 	for (prev = p = *h; p != sym; prev = p, p = p->hash)
 		/* nothing */;
 	if (prev == p)
@@ -72,8 +122,7 @@ unlinkhash(Symbol *sym)
 void
 pushctx(void)
 {
-	if (++curctx == NR_BLOCK+1)
-		error("too much nested blocks");
+	++curctx;
 }
 
 void
@@ -84,7 +133,7 @@ killsym(Symbol *sym)
 
 	f = sym->flags;
 	if (f & ISSTRING)
-		free(sym->u.s);
+		xfree(sym->u.s);
 	if (sym->ns == NS_TAG)
 		sym->type->defined = 0;
 	unlinkhash(sym);
@@ -94,8 +143,10 @@ killsym(Symbol *sym)
 		if ((f & ISDEFINED) == 0 && sym->ns == NS_LABEL)
 			errorp("label '%s' is not defined", name);
 	}
-	free(name);
-	free(sym);
+	xfree(name);
+	xfree(sym);
+	++stats.freed;
+	--stats.live;
 }
 
 void
@@ -112,7 +163,7 @@ popctx(void)
 		}
 		labels = NULL;
 		if (curfun) {
-			free(curfun->u.pars);
+			xfree(curfun->u.pars);
 			curfun->u.pars = NULL;
 		}
 	}
@@ -124,10 +175,10 @@ popctx(void)
 	head = sym;
 }
 
-static unsigned short
+static unsigned
 newid(void)
 {
-	unsigned short id;
+	unsigned id;
 
 	id = ++counterid;
 	if (id == 0) {
@@ -140,7 +191,7 @@ newid(void)
 Type *
 duptype(Type *base)
 {
-	Type *tp = xmalloc(sizeof(*tp));
+	Type *tp = xmalloctag(sizeof(*tp), MEM_TYPE);
 
 	*tp = *base;
 	tp->id = newid();
@@ -152,18 +203,23 @@ allocsym(int ns, char *name)
 {
 	Symbol *sym;
 
-	sym = xmalloc(sizeof(*sym));
-	if (name)
+	sym = xmalloctag(sizeof(*sym), MEM_SYMBOL);
+	if (name) {
+		sym->hval = hash(name);
 		name = xstrdup(name);
+	}
 	sym->name = name;
 	sym->id = 0;
 	sym->ns = ns;
-	sym->ctx = (ns == NS_CPP) ? UCHAR_MAX : curctx;
+	sym->ctx = (ns == NS_CPP) ? UINT_MAX : curctx;
 	sym->token = IDEN;
 	sym->flags = 0;
 	sym->u.s = NULL;
 	sym->type = NULL;
 	sym->next = sym->hash = NULL;
+	if (++stats.live > stats.peak)
+		stats.peak = stats.live;
+	++stats.alloc;
 	return sym;
 }
 
@@ -200,7 +256,7 @@ linkhash(Symbol *sym)
 {
 	Symbol **h, *p, *prev;
 
-	h = &htab[hash(sym->name)];
+	h = &htab[sym->hval & NR_SYM_HASH-1];
 	for (prev = p = *h; p; prev = p, p = p->hash) {
 		if (p->ctx <= sym->ctx)
 			break;
@@ -234,17 +290,28 @@ newlabel(void)
 	return sym;
 }
 
+Symbol *
+newtemp(Type *tp)
+{
+	Symbol *sym = newsym(NS_IDEN);
+	sym->type = tp;
+	sym->flags |= ISAUTO|ISUSED;
+	sym->id = newid();
+	return sym;
+}
+
 Symbol *
 lookup(int ns, char *name)
 {
 	Symbol *sym;
 	int sns;
-	char *t, c;
+	unsigned long probes = 0;
+	unsigned h;
 
-	c = *name;
-	for (sym = htab[hash(name)]; sym; sym = sym->hash) {
-		t = sym->name;
-		if (*t != c || strcmp(t, name))
+	h = hash(name);
+	for (sym = htab[h & NR_SYM_HASH-1]; sym; sym = sym->hash) {
+		++probes;
+		if (sym->hval != h || strcmp(sym->name, name))
 			continue;
 		sns = sym->ns;
 		/*
@@ -258,21 +325,26 @@ lookup(int ns, char *name)
 		 * fields of such types.
 		 */
 		if (sns == NS_CPP || sns == ns)
-			return sym;
+			goto found;
 		if (ns == NS_CPP)
 			continue;
 		if (sns == NS_KEYWORD ||
 		    (sym->flags & ISTYPEDEF) && ns >= NS_STRUCTS) {
-			return sym;
+			goto found;
 		}
 	}
+	countlookup(ns, probes, 0);
 	return allocsym(ns, name);
+
+found:
+	countlookup(ns, probes, 1);
+	return sym;
 }
 
 Symbol *
 nextsym(Symbol *sym, int ns)
 {
-	char *s, *t, c;
+	char *s;
 	Symbol *p;
 
 	/*
@@ -282,10 +354,8 @@ nextsym(Symbol *sym, int ns)
 	 *      int x = x(y);
 	 */
 	s = sym->name;
-	c = *s;
 	for (p = sym->hash; p; p = p->hash) {
-		t = p->name;
-		if (c == *t && !strcmp(s, t))
+		if (p->hval == sym->hval && !strcmp(s, p->name))
 			return p;
 	}
 	return allocsym(ns, s);
@@ -12,8 +12,8 @@ A3	I	x
 	A3	#I0	:I
 	A3	A3	#I2	+I	:I
 	A3	A3	#I1	-I	:I
-	A3	A3	#I6	*I	:I
-	A3	A3	#I2	/I	:I
+	A3	A3	#I2	lI	A3	#I1	lI	+I	:I
+	A3	A3	A3	#IF	rI	#I1	&I	+I	#I1	rI	:I
 	A3	A3	#I2	%I	:I
 	A3	A3	#I2	lI	:I
 	A3	A3	#I1	rI	:I
@@ -16,13 +16,13 @@ A9	P	q
 V10	I	#4
 A11	V10	v
 	A7	A5	'P	:P
-	A9	A5	'P	#P4	+P	#P3	+P	:P
-	A5	'P	#P4	+P	#P3	+P	@K	#K2	:K
+	A9	A5	'P	#P7	+P	:P
+	A5	'P	#P7	+P	@K	#K2	:K
 	A11	#I2	:I
-	j	L13	A5	'P	#P4	+P	#P3	+P	@K	gI	#I2	=I
+	j	L13	A5	'P	#P7	+P	@K	gI	#I2	=I
 	r	#I1
 L13
-	j	L14	A7	#P4	+P	#P3	+P	@K	gI	#I2	=I
+	j	L14	A7	#P7	+P	@K	gI	#I2	=I
 	r	#I1
 L14
 	j	L15	A9	@K	gI	#I2	=I
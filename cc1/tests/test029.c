@@ -15,7 +15,7 @@ G3	F2	f1
 {
 \
 A4	I	f
-	A4	#I2	*I
+	A4	#I1	lI
 }
 
 */
@@ -0,0 +1,37 @@
+/*
+name: TEST045
+description: Test the bounds of the shifts of the strength reduction
+error:
+
+output:
+G1	N	u
+G2	Z	l
+G3	I	i
+F4	I	E
+G5	F4	main
+{
+\
+	G1	G1	#NFFFF	*N	:N
+	G2	G2	#ZFFFFFFFF	*Z	:Z
+	G1	G1	#N8	lN	G1	-N	:N
+	G3	G3	#I7	lI	:I
+	G3	G3	#IA	lI	#IA	lI	:I
+	r	#I0
+}
+
+*/
+
+unsigned u;
+unsigned long l;
+int i;
+
+int
+main()
+{
+	u = u * 65535u;
+	l = l * 4294967295ul;
+	u = u * 255u;
+	i = i << 3 << 4;
+	i = i << 10 << 10;
+	return 0;
+}
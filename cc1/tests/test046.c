@@ -0,0 +1,41 @@
+/*
+name: TEST046
+description: Test the order of the common subexpressions
+error:
+
+output:
+G1	I	a
+G2	I	b
+G3	I	c
+G4	I	d
+F5	I	E
+G6	F5	main
+{
+\
+A8	I
+A7	I
+	A8	G1	G2	+I	:I	A7	A8	G3	*I	:I	,I	G4	A7	A7	+I	A8	+I	:I	,I
+	j	L11
+	e
+L9
+	G4	G4	#I1	-I	:I
+L11
+A12	I
+	j	L9	A12	G1	G2	*I	:I	A12	A12	+I	#IA	<I	,I
+	b
+L10
+	r	#I0
+}
+
+*/
+
+int a, b, c, d;
+
+int
+main()
+{
+	d = (a+b)*c + (a+b)*c + (a+b);
+	while ((a*b) + (a*b) < 10)
+		d = d - 1;
+	return 0;
+}
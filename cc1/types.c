@@ -11,6 +11,8 @@
 
 #define NR_TYPE_HASH 16
 
+static unsigned long nmktype, nmkhits;
+
 /*
  * Compiler can generate warnings here if the ranges of TINT,
  * TUINT and TFLOAT are smaller than any of the constants in this
@@ -392,7 +394,7 @@ invalid_type:
 	error("invalid type specification");
 }
 
-static TINT
+TINT
 typesize(Type *tp)
 {
 	Symbol **sp;
@@ -439,8 +441,11 @@ mktype(Type *tp, int op, TINT nelem, Type *pars[])
 	Type *bp;
 	int c, k_r = 0;
 
-	if (op == PTR && tp == voidtype)
+	++nmktype;
+	if (op == PTR && tp == voidtype) {
+		++nmkhits;
 		return pvoidtype;
+	}
 
 	if (op == KRFTN) {
 		k_r = 1;
@@ -468,7 +473,13 @@ mktype(Type *tp, int op, TINT nelem, Type *pars[])
 	type.p.pars = pars;
 	type.n.elem = nelem;
 	type.ns = 0;
-	/* TODO: Set aligment for new types */
+	/* the pointers are aligned to 2, as in cc2 */
+	if (op == PTR)
+		type.align = pvoidtype->align;
+	else if (op == ARY)
+		type.align = tp->align;
+	else
+		type.align = 1;
 
 	switch (op) {
 	case ARY:
@@ -500,7 +511,8 @@ mktype(Type *tp, int op, TINT nelem, Type *pars[])
 			 * but the type already exists, so
 			 * we have to deallocted it
 			 */
-			free(pars);
+			xfree(pars);
+			++nmkhits;
 			return bp;
 		}
 	}
@@ -511,6 +523,14 @@ mktype(Type *tp, int op, TINT nelem, Type *pars[])
 	return *tbl = bp;
 }
 
+void
+typestats(void)
+{
+	fprintf(stderr, "mktype: %lu calls, %lu cache hits (%.1f%%)\n",
+	        nmktype, nmkhits,
+	        (nmktype) ? 100.0 * nmkhits / nmktype : 0.0);
+}
+
 bool
 eqtype(Type *tp1, Type *tp2)
 {
@@ -527,9 +547,12 @@ eqtype(Type *tp1, Type *tp2)
 			return 0;
 	case PTR:
 		return eqtype(tp1->type, tp2->type);
+	case FTN:
+		if (tp1->op != tp2->op || !eqtype(tp1->type, tp2->type))
+			return 0;
+		/* PASSTROUGH */
 	case UNION:
 	case STRUCT:
-	case FTN:
 		if (tp1->op != tp2->op || tp1->n.elem != tp2->n.elem)
 			return 0;
 		p1 = tp1->p.pars, p2 = tp2->p.pars;
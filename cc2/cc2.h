@@ -9,20 +9,23 @@
 #define PAR       'P'
 #define CONST     '#'
 #define INDEX     'I'
+#define INDEXY    'X'
 #define LABEL     'L'
+#define COND      'F'
 #define OADD      '+'
 #define OSUB      '-'
 #define OASSIG    ':'
 #define OINC      ';'
 #define OMOD      '%'
 #define ODIV      '/'
+#define OMUL      '*'
 #define OSHL      'l'
 #define OSHR      'r'
 #define OBAND     '&'
 #define OBOR      '|'
 #define OBXOR     '^'
 #define OPTR      '@'
-#define OADDR     'a'
+#define OADDR     '\''
 #define OLT       '<'
 #define OGT       '>'
 #define OGE       ']'
@@ -30,21 +33,32 @@
 #define OEQ       '='
 #define ONE       '!'
 #define OOR       'o'
-#define OAND      'y'
+#define OAND      'a'
 #define OCAST     'c'
 #define ONEG      '_'
 #define OCPL      '~'
 #define OCOMMA    ','
+#define OCALL     'C'
+#define OPAR      'p'
+#define OFIELD    '.'
+#define OASK      '?'
+#define OCOLON    'k'
 #define ORET      'y'
-
-#define ADDABLE 10
-
+#define OJMP      'j'
+#define OSWITCH   's'
+#define OTABLE    't'
+#define OCASE     'v'
+#define ODEFAULT  'f'
+#define OBLOOP    'b'
+#define OELOOP    'e'
 
 typedef struct symbol Symbol;
 typedef struct node Node;
 typedef struct inst Inst;
 typedef struct addr Addr;
 typedef struct type Type;
+typedef struct func Func;
+typedef struct block Block;
 
 struct type {
 	unsigned short size;
@@ -54,25 +68,20 @@ struct type {
 };
 
 struct symbol {
-	unsigned short id;
+	unsigned id;
 	char *name;
 	char kind;
 	bool public : 1;
 	bool extrn : 1;
-	bool index : 1;
 	union {
-		/* TODO: Admit inmediate of other type */
-		TINT imm;
 		struct {
 			Type type;
 			char sclass;
 			short off;
 		} v;
-		Inst *pc;
 		struct {
 			short locals;
 			short params;
-			Node **body;
 		} f;
 	} u;
 };
@@ -81,17 +90,17 @@ struct node {
 	uint8_t op;
 	uint8_t subop;
 	Type type;
-	uint8_t complex;
-	uint8_t addable;
 	uint8_t reg;
 	Symbol *sym;
-	bool used : 1;
+	TINT imm;                   /* value of CONST and INDEXY nodes */
+	unsigned state;             /* costs of the node, see isel.c */
 	struct node *left, *right;
 };
 
 
 struct addr {
 	char kind;
+	short off;                  /* added to the address of MEM */
 	union {
 		uint8_t reg;
 		TINT i;
@@ -103,22 +112,19 @@ struct inst {
 	uint8_t op;
 	Addr from, to;
 	Symbol *label;
-	Inst *next, *prev;
 };
 
+
 enum nerrors {
-	EINTNUM,       /* too much internal identifiers */
-	EEXTNUM,       /* too much external identifiers */
-	EPARNUM,       /* too much parameters */
-	ENODEOV,       /* node overflow */
-	ESTACKO,       /* stack overflow */
 	ESTACKU,       /* stack underflow */
-	EEXPROV,       /* expression overflow */
 	ETYPERR,       /* incorrect type in expression */
 	EEXPBAL,       /* expression not balanced */
 	ESYNTAX,       /* syntax error */
-	ELNLINE,       /* line too long */
+	ELABEL,        /* undefined label */
 	EFERROR,       /* error reading from file:%s*/
+	EENCODE,       /* cannot encode '%s' */
+	EFUNSIZ,       /* function too large */
+	ESELECT,       /* cannot select the instructions of '%s' */
 	ENUMERR
 };
 
@@ -141,7 +147,19 @@ enum {
 	OR,
 	XOR,
 	CPL,
-	NEG
+	NEG,
+	ADC,
+	SBC,
+	CP,
+	CALL,
+	SRA,
+	SRL,
+	RR
+};
+
+/* the conditions of JP, in the order of their encoding */
+enum {
+	CCNZ, CCZ, CCNC, CCC, CCPO, CCPE, CCP, CCM
 };
 
 enum {
@@ -150,30 +168,113 @@ enum {
 	SP = NPAIRS, IX
 };
 
-extern Symbol *curfun;
-extern Inst *prog, *pc;
+struct regvar {
+	Symbol *sym;
+	uint8_t reg;
+};
+
+/*
+ * A basic block is a sequence of statements of the body of a
+ * function, which begins with a label or after a jump
+ */
+struct block {
+	unsigned begin, end;        /* statements in [begin, end) */
+	Block **succs, **preds;
+	unsigned nsuccs, npreds;
+	unsigned rpo;               /* position in reverse postorder */
+	unsigned long *in, *out;    /* live variables, see live.c */
+};
+
+/*
+ * Everything needed to generate the code of a function is kept
+ * here, so different functions can be generated at the same time
+ */
+struct func {
+	Symbol *sym;
+	Node **body;                /* statements, ended with NULL */
+	unsigned nstmts, maxstmts;
+	Node **nodeblks;            /* nodes, in blocks of NR_NODEBLK */
+	unsigned nrnodes, nrblks;
+	Block *blocks;              /* control flow graph of the body */
+	unsigned nblocks;
+	Block **rpo;                /* reachable blocks in reverse postorder */
+	unsigned nrpo;
+	Block **edges;              /* storage of succs and preds */
+	Symbol **vars;              /* variables tracked by liveness */
+	unsigned nvars, setsiz;
+	unsigned long *sets;        /* storage of in and out */
+	Node *reguse[NPAIRS];       /* variables in A and HL, see isel.c */
+	struct regvar *regvars;     /* variables kept in registers */
+	unsigned nregvars;
+	bool varregs[NPAIRS];       /* registers used by the variables */
+	Symbol retlabel;
+	Symbol **labels;            /* labels made by cgen.c and isel.c */
+	unsigned nlabels;
+	Inst *prog;                 /* instructions, with a gap */
+	unsigned ninst, tail, maxinst;
+	Symbol *label;              /* label of the next instruction */
+	char *out;                  /* assembler of the function */
+	size_t outlen, outsiz;
+	bool done;                  /* the code is generated */
+	Func *next;
+};
 
 /* main.c */
 extern void error(unsigned nerror, ...);
+extern void codegen(void);
+extern void initjobs(int n);
+extern void endjobs(void);
 
 /* cgen.c */
-extern void addable(void);
-extern void generate(void);
-extern void apply(Node *(*fun)(Node *));
+extern void generate(Func *fn);
+extern Symbol *newlabel(Func *fn);
+extern void deflabel(Func *fn, Symbol *sym);
+
+/* isel.c */
+extern void selstmt(Func *fn, Node *np);
+extern void selvalue(Func *fn, Node *np);
+extern void selbranch(Func *fn, Node *np, Symbol *label);
+extern void selcase(Func *fn, Node *np);
 
 /* parser.c */
-extern void parse(void);
+extern void setinput(char *buf, size_t len);
+extern bool moreinput(void);
+extern Func *parse(void);
+extern void delfun(Func *fn);
+extern void apply(Func *fn, Node *(*fun)(Node *));
 extern void prtree(Node *np);
+extern Node *imm(Func *fn, TINT i);
 
 /* code.c */
-extern void code(uint8_t op, Node *to, Node *from);
-extern void inscode(uint8_t op, Addr *to, Addr *from);
-extern void writeout(void);
-extern void delcode(void);
+extern void code(Func *fn, uint8_t op, Node *to, Node *from);
+extern void inscode(Func *fn, uint8_t op, Addr *to, Addr *from);
+extern void writeout(Func *fn);
+extern void delcode(Func *fn);
+extern void startcode(Func *fn);
+extern Inst *nextcode(Func *fn);
+extern char *reserve(Func *fn, size_t n);
+extern char *insttxt(Func *fn, Inst *pc);
+
+/* encode.c */
+extern void writeobj(Func *fn);
+extern void initobj(void);
+extern bool objout;
+
+/* cfg.c */
+extern void buildcfg(Func *fn);
+
+/* live.c */
+extern void liveness(Func *fn);
+extern void deadstores(Func *fn);
+extern int varidx(Func *fn, Symbol *sym);
+extern bool islive(unsigned long *set, int idx);
+
+/* regalloc.c */
+extern void regalloc(Func *fn);
 
 /* optm.c */
-extern void optimize(void);
-extern Node *imm(TINT i);
+extern void optimize(Func *fn);
 
 /* peep.c */
-extern void peephole(void);
+extern void peephole(Func *fn);
+extern void peepstats(void);
@@ -0,0 +1,242 @@
+
+#include <inttypes.h>
+#include <limits.h>
+#include <stdlib.h>
+
+#include "../inc/cc.h"
+#include "cc2.h"
+
+/*
+ * The control flow graph is built over the statements of the
+ * body. A block begins with a label, or after a statement that
+ * changes the flow: jumps, returns and switches. The switch table
+ * is data after a label that is only used by the switch, so the
+ * successors of the switch are the labels of the entries of the
+ * table, and the block of the table does not have successors.
+ * When there is no default entry the switch goes to the block
+ * after the table.
+ */
+#define NOTVISITED UINT_MAX
+
+struct label {
+	unsigned id;
+	Block *bp;
+};
+
+static int
+cmplabel(const void *p1, const void *p2)
+{
+	const struct label *l1 = p1, *l2 = p2;
+
+	return (l1->id > l2->id) - (l1->id < l2->id);
+}
+
+static Block *
+lookup(struct label *labels, unsigned n, Symbol *sym)
+{
+	struct label key, *lp;
+
+	key.id = sym->id;
+	lp = bsearch(&key, labels, n, sizeof(*labels), cmplabel);
+	if (!lp)
+		error(ELABEL);
+	return lp->bp;
+}
+
+static bool
+endblock(Node *np)
+{
+	switch (np->op) {
+	case OJMP:
+	case ORET:
+	case OSWITCH:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+/* returns the number of statements that begin a block */
+static unsigned
+leaders(Func *fn)
+{
+	Node **stmt, *np, *prev = NULL;
+	unsigned n = 0;
+
+	for (stmt = fn->body; np = *stmt; ++stmt) {
+		if (!prev || np->op == LABEL || endblock(prev))
+			++n;
+		prev = np;
+	}
+	return n;
+}
+
+static void
+addsucc(Func *fn, Block *bp, Block *to, unsigned *nedges, unsigned *max)
+{
+	Block **p, **end = &fn->edges[*nedges];
+
+	/* several entries of a switch table can use the same label */
+	for (p = end - bp->nsuccs; p < end; ++p) {
+		if (*p == to)
+			return;
+	}
+	if (*nedges == *max) {
+		*max = (*max) ? 2 * *max : 32;
+		fn->edges = xrealloc(fn->edges, *max * sizeof(Block *));
+	}
+	fn->edges[(*nedges)++] = to;
+	++bp->nsuccs;
+	++to->npreds;
+}
+
+static void
+numberblocks(Func *fn)
+{
+	struct visit {
+		Block *bp;
+		unsigned next;
+	} *stack, *sp;
+	Block *bp, *to, **post;
+	unsigned i, npost = 0;
+
+	for (i = 0; i < fn->nblocks; ++i)
+		fn->blocks[i].rpo = NOTVISITED;
+	if (fn->nblocks == 0)
+		return;
+
+	sp = stack = xmalloc(fn->nblocks * sizeof(*stack));
+	post = xmalloc(fn->nblocks * sizeof(*post));
+	sp->bp = fn->blocks;
+	sp->next = 0;
+	sp->bp->rpo = 0;
+
+	while (sp >= stack) {
+		bp = sp->bp;
+		if (sp->next == bp->nsuccs) {
+			post[npost++] = bp;
+			--sp;
+			continue;
+		}
+		to = bp->succs[sp->next++];
+		if (to->rpo != NOTVISITED)
+			continue;
+		to->rpo = 0;
+		++sp;
+		sp->bp = to;
+		sp->next = 0;
+	}
+
+	for (i = 0; i < npost; ++i) {
+		bp = post[npost-1 - i];
+		bp->rpo = i;
+		fn->rpo[i] = bp;
+	}
+	fn->nrpo = npost;
+	xfree(stack);
+	xfree(post);
+}
+
+void
+buildcfg(Func *fn)
+{
+	Node **body = fn->body, *np;
+	Block *bp, *to, *end, **edge;
+	struct label *labels;
+	unsigned i, n, nlabels, nedges, max;
+	bool dflt;
+
+	xfree(fn->blocks);
+	xfree(fn->rpo);
+	xfree(fn->edges);
+	fn->edges = NULL;
+
+	n = leaders(fn);
+	fn->nblocks = n;
+	fn->blocks = xcalloc((n) ? n : 1, sizeof(Block));
+	fn->rpo = xmalloc(((n) ? n : 1) * sizeof(Block *));
+	fn->nrpo = 0;
+	labels = xmalloc(((n) ? n : 1) * sizeof(*labels));
+	nlabels = 0;
+
+	/* split the body in blocks, and find the blocks of the labels */
+	bp = fn->blocks - 1;
+	for (i = 0; np = body[i]; ++i) {
+		if (i == 0 || np->op == LABEL || endblock(body[i-1])) {
+			if (bp >= fn->blocks)
+				bp->end = i;
+			++bp;
+			bp->begin = i;
+		}
+		if (np->op == LABEL) {
+			labels[nlabels].id = np->sym->id;
+			labels[nlabels++].bp = bp;
+		}
+	}
+	if (n > 0)
+		bp->end = i;
+	qsort(labels, nlabels, sizeof(*labels), cmplabel);
+
+	/*
+	 * The successors of every block are stored consecutively in
+	 * edges, and the predecessors are stored after all of them
+	 */
+	end = &fn->blocks[n];
+	nedges = max = 0;
+	for (bp = fn->blocks; bp < end; ++bp) {
+		np = body[bp->end-1];
+		switch (np->op) {
+		case OSWITCH:
+			to = lookup(labels, nlabels, np->sym);
+			dflt = 0;
+			for (i = to->begin; i < to->end; ++i) {
+				np = body[i];
+				if (np->op == ODEFAULT)
+					dflt = 1;
+				else if (np->op != OCASE)
+					continue;
+				addsucc(fn, bp, lookup(labels, nlabels, np->sym),
+				        &nedges, &max);
+			}
+			if (!dflt && to+1 < end)
+				addsucc(fn, bp, to+1, &nedges, &max);
+			break;
+		case ORET:
+		case OTABLE:
+		case OCASE:
+		case ODEFAULT:
+			break;
+		case OJMP:
+			addsucc(fn, bp, lookup(labels, nlabels, np->sym),
+			        &nedges, &max);
+			if (!np->left)
+				break;
+			/* PASSTROUGH */
+		default:
+			if (bp+1 < end)
+				addsucc(fn, bp, bp+1, &nedges, &max);
+			break;
+		}
+	}
+	fn->edges = xrealloc(fn->edges, (2*nedges + 1) * sizeof(Block *));
+	xfree(labels);
+
+	edge = fn->edges;
+	for (bp = fn->blocks; bp < end; ++bp) {
+		bp->succs = edge;
+		edge += bp->nsuccs;
+	}
+	for (bp = fn->blocks; bp < end; ++bp) {
+		bp->preds = edge;
+		edge += bp->npreds;
+		bp->npreds = 0;
+	}
+	for (bp = fn->blocks; bp < end; ++bp) {
+		for (i = 0; i < bp->nsuccs; ++i) {
+			to = bp->succs[i];
+			to->preds[to->npreds++] = bp;
+		}
+	}
+
+	numberblocks(fn);
+}
@@ -1,12 +1,14 @@
 
-#include <stdarg.h>
 #include <stdlib.h>
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "../inc/cc.h"
 #include "cc2.h"
 
+#define NR_INSTS 64
+
 static char *regnames[] = {
 	[AF] = "AF",
 	[HL] = "HL", [DE] = "DE", [BC] = "BC",
@@ -18,9 +20,10 @@ static char *regnames[] = {
 	[IYL]= "IYL",[IYH]= "IYH"
 };
 
-static void inst0(void), inst1(void), inst2(void);
+static void inst0(Func *, Inst *), inst1(Func *, Inst *),
+            inst2(Func *, Inst *), jump(Func *, Inst *);
 
-static void (*instcode[])(void) = {
+static void (*instcode[])(Func *, Inst *) = {
 	[LDW] = inst2,
 	[LDL] = inst2,
 	[LDH] = inst2,
@@ -34,13 +37,19 @@ static void (*instcode[])(void) = {
 	[INC] = inst1,
 	[SUB] = inst2,
 	[DEC] = inst1,
-	[JP] = inst1,
+	[JP] = jump,
 	[AND] = inst2,
 	[OR] = inst2,
 	[XOR] = inst2,
 	[CPL] = inst1,
-	[NEG] = inst1
-
+	[NEG] = inst1,
+	[ADC] = inst2,
+	[SBC] = inst2,
+	[CP] = inst2,
+	[CALL] = jump,
+	[SRA] = inst1,
+	[SRL] = inst1,
+	[RR] = inst1
 };
 
 static char *insttext[] = {
@@ -62,43 +71,65 @@ static char *insttext[] = {
 	[OR] = "OR",
 	[XOR] = "XOR",
 	[CPL] = "CPL",
-	[NEG] = "NEG"
+	[NEG] = "NEG",
+	[ADC] = "ADC",
+	[SBC] = "SBC",
+	[CP] = "CP",
+	[CALL] = "CALL",
+	[SRA] = "SRA",
+	[SRL] = "SRL",
+	[RR] = "RR"
 };
 
-Inst *pc, *prog;
+static char *condnames[] = {
+	[CCNZ] = "NZ", [CCZ] = "Z", [CCNC] = "NC", [CCC] = "C",
+	[CCPO] = "PO", [CCPE] = "PE", [CCP] = "P", [CCM] = "M"
+};
 
+/*
+ * The instructions of a function are kept in an array with a gap.
+ * The current instruction is the last one before the gap, in
+ * prog[ninst-1], and the instructions after the current one are
+ * in [tail, maxinst). The code is generated at the end of the
+ * array, and the gap is only moved by peephole(), which walks
+ * the program with startcode() and nextcode(). When it finishes
+ * the gap is again at the end, and the array is compacted.
+ */
 static void
-nextpc(void)
+nextpc(Func *fn)
 {
 	Inst *new;
+	unsigned siz, n;
 
-	new = xmalloc(sizeof(*new));
-
-	if (!pc) {
-		new->next = NULL;
-		prog = new;
-	} else {
-		new->next = pc->next;
-		pc->next = new;
+	if (fn->ninst == fn->tail) {
+		siz = (fn->maxinst) ? 2*fn->maxinst : NR_INSTS;
+		fn->prog = xrealloctag(fn->prog, siz * sizeof(Inst), MEM_INST);
+		n = fn->maxinst - fn->tail;
+		memmove(&fn->prog[siz-n], &fn->prog[fn->tail], n * sizeof(Inst));
+		fn->tail = siz - n;
+		fn->maxinst = siz;
 	}
 
-	new->prev = pc;
+	new = &fn->prog[fn->ninst++];
 	new->to.kind = NONE;
 	new->from.kind = NONE;
-	pc = new;
+	new->label = fn->label;
+	fn->label = NULL;
 }
 
 void
 addr(char op, Node *np, Addr *addr)
 {
+	addr->off = 0;
 	switch (addr->kind = np->op) {
 	case REG:
 		addr->u.reg = np->reg;
 		break;
 	case CONST:
-		addr->u.i = np->sym->u.imm;
+		addr->u.i = np->imm;
 		break;
 	case AUTO:
+	case PAR:
 		addr->u.i = np->sym->u.v.off;
 		break;
 	case LABEL:
@@ -113,10 +144,12 @@ addr(char op, Node *np, Addr *addr)
 }
 
 void
-code(uint8_t op, Node *to, Node *from)
+code(Func *fn, uint8_t op, Node *to, Node *from)
 {
+	Inst *pc;
 
-	nextpc();
+	nextpc(fn);
+	pc = &fn->prog[fn->ninst-1];
 	if (from)
 		addr(op, from, &pc->from);
 	if (to)
@@ -125,9 +158,12 @@ code(uint8_t op, Node *to, Node *from)
 }
 
 void
-inscode(uint8_t op, Addr *to, Addr *from)
+inscode(Func *fn, uint8_t op, Addr *to, Addr *from)
 {
-	nextpc();
+	Inst *pc;
+
+	nextpc(fn);
+	pc = &fn->prog[fn->ninst-1];
 	if (from)
 		pc->from = *from;
 	if (to)
@@ -135,65 +171,199 @@ inscode(uint8_t op, Addr *to, Addr *from)
 	pc->op = op;
 }
 
+/*
+ * Remove the current instruction, the previous one
+ * becomes the current one
+ */
 void
-delcode(void)
+delcode(Func *fn)
+{
+	--fn->ninst;
+}
+
+/*
+ * Move all the instructions after the gap, so the walk
+ * begins before the first instruction
+ */
+void
+startcode(Func *fn)
+{
+	unsigned n = fn->ninst;
+
+	fn->tail -= n;
+	memmove(&fn->prog[fn->tail], fn->prog, n * sizeof(Inst));
+	fn->ninst = 0;
+}
+
+/*
+ * Move the instruction after the current one before the gap,
+ * and make it the current one
+ */
+Inst *
+nextcode(Func *fn)
+{
+	Inst *pc;
+
+	if (fn->tail == fn->maxinst)
+		return NULL;
+	pc = &fn->prog[fn->ninst++];
+	if (pc != &fn->prog[fn->tail])
+		*pc = fn->prog[fn->tail];
+	++fn->tail;
+	return pc;
+}
+
+/*
+ * The assembler of every function is written in its own buffer,
+ * because the functions can be generated in any order, and
+ * they have to be written in the order of the source. The text
+ * is formatted here, without stdio, because writeout() formats
+ * several fields for every instruction.
+ */
+char *
+reserve(Func *fn, size_t n)
+{
+	size_t siz = fn->outsiz;
+
+	if (siz - fn->outlen < n) {
+		do
+			siz = (siz) ? 2*siz : BUFSIZ;
+		while (siz - fn->outlen < n);
+		fn->out = xrealloctag(fn->out, siz, MEM_STRING);
+		fn->outsiz = siz;
+	}
+	return fn->out + fn->outlen;
+}
+
+static void
+outs(Func *fn, char *s)
 {
-	Inst *prev = pc->prev, *next = pc->next;
+	size_t len = strlen(s);
 
-	free(pc);
-	if (!prev) {
-		pc = next;
-		prog = NULL;
+	memcpy(reserve(fn, len), s, len);
+	fn->outlen += len;
+}
+
+static void
+outc(Func *fn, int c)
+{
+	*reserve(fn, 1) = c;
+	++fn->outlen;
+}
+
+/* write a decimal number, with a sign always when sign is true */
+static void
+outnum(Func *fn, TINT n, bool sign)
+{
+	char buf[24], *bp = &buf[sizeof(buf)];
+	TUINT u = (n < 0) ? -(TUINT) n : n;
+	size_t len;
+
+	do
+		*--bp = '0' + u % 10;
+	while ((u /= 10) != 0);
+	if (n < 0)
+		*--bp = '-';
+	else if (sign)
+		*--bp = '+';
+
+	len = &buf[sizeof(buf)] - bp;
+	memcpy(reserve(fn, len), bp, len);
+	fn->outlen += len;
+}
+
+/* the labels made by the back end have a name */
+static void
+outlabel(Func *fn, Symbol *sym)
+{
+	if (sym->name) {
+		outs(fn, sym->name);
 	} else {
-		pc = prev;
-		prev->next = next;
-		if (next)
-			next->prev = prev;
+		outc(fn, 'L');
+		outnum(fn, sym->id, 0);
 	}
 }
 
 void
-writeout(void)
+writeout(Func *fn)
 {
-	if (!prog)
-		return;
+	Inst *pc, *end = &fn->prog[fn->ninst];
 
-	for (pc = prog; pc; pc = pc->next) {
-		if (pc->label)
-			printf("L%d:", pc->label->id);
-		(*instcode[pc->op])();
+	if (objout) {
+		writeobj(fn);
+		return;
+	}
+	outs(fn, fn->sym->name);
+	outs(fn, ":\n");
+	for (pc = fn->prog; pc < end; ++pc) {
+		if (pc->label) {
+			outlabel(fn, pc->label);
+			outc(fn, ':');
+		}
+		(*instcode[pc->op])(fn, pc);
 	}
 }
 
+/* the text of an instruction, for the error messages */
+char *
+insttxt(Func *fn, Inst *pc)
+{
+	size_t len = fn->outlen;
+	char *s, *p;
+
+	(*instcode[pc->op])(fn, pc);
+	fn->out[fn->outlen-1] = '\0';
+	fn->outlen = len;
+	s = fn->out + len + 1;
+	if ((p = strchr(s, '\t')) != NULL)
+		*p = ' ';
+	return s;
+}
+
 static void
-addr2txt(uint8_t op, Addr *a)
+addr2txt(Func *fn, uint8_t op, Addr *a)
 {
 	Symbol *sym;
+	bool ind = op != LDI && op != JP && op != CALL;
 
 	switch (a->kind) {
 	case REG:
-		fputs(regnames[a->u.reg], stdout);
+		outs(fn, regnames[a->u.reg]);
 		break;
 	case CONST:
-		printf("%d", a->u.i);
+		outnum(fn, (int) a->u.i, 0);
 		break;
 	case PAR:
 	case AUTO:
-		printf("(IX%+d)", a->u.i);
+		outs(fn, "(IX");
+		outnum(fn, (int) a->u.i, 1);
+		outc(fn, ')');
 		break;
 	case LABEL:
-		sym = a->u.sym;
-		printf("L%d", sym->id);
+		outlabel(fn, a->u.sym);
 		break;
 	case INDEX:
-		fputs("(HL)", stdout);
+		outs(fn, "(HL)");
+		break;
+	case INDEXY:
+		outs(fn, "(IY");
+		outnum(fn, (int) a->u.i, 1);
+		outc(fn, ')');
 		break;
 	case MEM:
 		sym = a->u.sym;
-		if (sym->name)
-			printf((op == LDI) ? "%s" : "(%s)", sym->name);
-		else
-			printf((op == LDI) ? "T%u" : "(T%u)", sym->id);
+		if (ind)
+			outc(fn, '(');
+		if (sym->name) {
+			outs(fn, sym->name);
+		} else {
+			outc(fn, 'T');
+			outnum(fn, sym->id, 0);
+		}
+		if (a->off)
+			outnum(fn, a->off, 1);
+		if (ind)
+			outc(fn, ')');
 		break;
 	default:
 		abort();
@@ -201,29 +371,51 @@ addr2txt(uint8_t op, Addr *a)
 }
 
 static void
-inst0(void)
+inst0(Func *fn, Inst *pc)
 {
-	printf("\t%s\n", insttext[pc->op]);
+	outc(fn, '\t');
+	outs(fn, insttext[pc->op]);
+	outc(fn, '\n');
 }
 
 static void
-inst1(void)
+inst1(Func *fn, Inst *pc)
 {
 	uint8_t op = pc->op;
 
-	printf("\t%s\t", insttext[op]);
-	addr2txt(op, (pc->to.kind != NONE) ? &pc->to : &pc->from);
-	putchar('\n');
+	outc(fn, '\t');
+	outs(fn, insttext[op]);
+	outc(fn, '\t');
+	addr2txt(fn, op, (pc->to.kind != NONE) ? &pc->to : &pc->from);
+	outc(fn, '\n');
+}
+
+static void
+jump(Func *fn, Inst *pc)
+{
+	uint8_t op = pc->op;
+
+	outc(fn, '\t');
+	outs(fn, insttext[op]);
+	outc(fn, '\t');
+	if (pc->from.kind == COND) {
+		outs(fn, condnames[pc->from.u.i]);
+		outc(fn, ',');
+	}
+	addr2txt(fn, op, &pc->to);
+	outc(fn, '\n');
 }
 
 static void
-inst2(void)
+inst2(Func *fn, Inst *pc)
 {
 	uint8_t op = pc->op;
 
-	printf("\t%s\t", insttext[op]);
-	addr2txt(op, &pc->to);
-	putchar(',');
-	addr2txt(op, &pc->from);
-	putchar('\n');
+	outc(fn, '\t');
+	outs(fn, insttext[op]);
+	outc(fn, '\t');
+	addr2txt(fn, op, &pc->to);
+	outc(fn, ',');
+	addr2txt(fn, op, &pc->from);
+	outc(fn, '\n');
 }
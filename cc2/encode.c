@@ -0,0 +1,581 @@
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../inc/cc.h"
+#include "cc2.h"
+
+/*
+ * With -c the instructions are encoded directly, and the output
+ * is a relocatable object instead of assembler text. The object
+ * begins with OBJMAGIC, followed by a record for every function:
+ *
+ *	name '\0'
+ *	size (2 bytes) and size bytes of code
+ *	number of relocations (2 bytes)
+ *	offset (2 bytes) and name '\0' of every relocation
+ *
+ * All the numbers are little endian. A relocation adds the address
+ * of the symbol to the word at the offset. The jumps to the labels
+ * of the function are resolved when the function is encoded, and
+ * they are relocated against the function itself.
+ */
+#define OBJMAGIC "scc\032"
+
+struct fixup {
+	size_t off;
+	Symbol *sym;
+};
+
+struct fixups {
+	struct fixup *v;
+	unsigned n, max;
+};
+
+struct enc {
+	Func *fn;
+	size_t base;               /* offset of the code in fn->out */
+	struct fixups relocs, jumps, labels;
+};
+
+struct operand {
+	int pfx;                   /* DD or FD prefix, 0 if none */
+	int code;                  /* register field of the opcode */
+	int disp;                  /* displacement of (IX+d) or (IY+d) */
+	bool hasdisp;
+};
+
+bool objout;
+
+static uint8_t r8[] = {
+	[B] = 0, [C] = 1, [D] = 2, [E] = 3,
+	[H] = 4, [L] = 5, [A] = 7,
+	[IYH] = 4, [IYL] = 5
+};
+
+static uint8_t r16[] = {
+	[BC] = 0, [DE] = 1, [HL] = 2, [SP] = 3,
+	[IX] = 2, [IY] = 2, [AF] = 3
+};
+
+static void
+byte(struct enc *ep, int b)
+{
+	Func *fn = ep->fn;
+
+	*reserve(fn, 1) = b;
+	++fn->outlen;
+}
+
+static void
+word(struct enc *ep, unsigned w)
+{
+	byte(ep, w & 0xFF);
+	byte(ep, w >> 8 & 0xFF);
+}
+
+static void
+addfix(struct fixups *fp, size_t off, Symbol *sym)
+{
+	struct fixup *p;
+
+	if (fp->n == fp->max) {
+		fp->max = (fp->max) ? 2*fp->max : 16;
+		fp->v = xrealloc(fp->v, fp->max * sizeof(*fp->v));
+	}
+	p = &fp->v[fp->n++];
+	p->off = off;
+	p->sym = sym;
+}
+
+static size_t
+offset(struct enc *ep)
+{
+	return ep->fn->outlen - ep->base;
+}
+
+static void
+outname(struct enc *ep, Symbol *sym)
+{
+	char buf[20], *s = sym->name;
+	size_t len;
+
+	if (!s) {
+		sprintf(buf, "T%u", sym->id);
+		s = buf;
+	}
+	len = strlen(s) + 1;
+	memcpy(reserve(ep->fn, len), s, len);
+	ep->fn->outlen += len;
+}
+
+/* the address of a symbol, fixed later by the linker */
+static void
+address(struct enc *ep, Addr *a)
+{
+	addfix(&ep->relocs, offset(ep), a->u.sym);
+	word(ep, a->off);
+}
+
+static bool
+ispair(Addr *a)
+{
+	return a->kind == REG && a->u.reg >= NREGS;
+}
+
+static int
+prefix(uint8_t reg)
+{
+	switch (reg) {
+	case IX:
+		return 0xDD;
+	case IY:
+	case IYL:
+	case IYH:
+		return 0xFD;
+	default:
+		return 0;
+	}
+}
+
+/* an instruction without encoding, as (IX+d) with d out of range */
+static void
+badinst(struct enc *ep, Inst *pc)
+{
+	error(EENCODE, insttxt(ep->fn, pc));
+}
+
+/*
+ * Operands that can be used in the register field of the 8 bits
+ * instructions. The upper byte of a variable in the stack frame
+ * is in the next position.
+ */
+static bool
+operand(Addr *a, bool upper, struct operand *op)
+{
+	op->pfx = 0;
+	op->hasdisp = 0;
+
+	switch (a->kind) {
+	case REG:
+		if (a->u.reg >= NREGS)
+			return 0;
+		op->code = r8[a->u.reg];
+		op->pfx = prefix(a->u.reg);
+		return 1;
+	case INDEX:
+		op->code = 6;
+		return 1;
+	case AUTO:
+	case PAR:
+		op->code = 6;
+		op->pfx = 0xDD;
+		op->disp = a->u.i + upper;
+		op->hasdisp = 1;
+		return op->disp >= -128 && op->disp <= 127;
+	case INDEXY:
+		op->code = 6;
+		op->pfx = 0xFD;
+		op->disp = a->u.i + upper;
+		op->hasdisp = 1;
+		return op->disp >= -128 && op->disp <= 127;
+	default:
+		return 0;
+	}
+}
+
+/* prefix, opcode and displacement of an instruction */
+static void
+emitop(struct enc *ep, struct operand *op, int opcode)
+{
+	if (op->pfx)
+		byte(ep, op->pfx);
+	byte(ep, opcode);
+	if (op->hasdisp)
+		byte(ep, op->disp);
+}
+
+static void
+ld16(struct enc *ep, Inst *pc)
+{
+	uint8_t reg = pc->to.u.reg, from;
+	Addr *a = &pc->from;
+	int pfx = prefix(reg);
+
+	switch (a->kind) {
+	case CONST:
+		if (pfx)
+			byte(ep, pfx);
+		byte(ep, 0x01 | r16[reg] << 4);
+		word(ep, a->u.i);
+		return;
+	case MEM:
+		if (pc->op == LDI) {
+			if (pfx)
+				byte(ep, pfx);
+			byte(ep, 0x01 | r16[reg] << 4);
+		} else if (r16[reg] == 2) {
+			if (pfx)
+				byte(ep, pfx);
+			byte(ep, 0x2A);
+		} else {
+			byte(ep, 0xED);
+			byte(ep, 0x4B | r16[reg] << 4);
+		}
+		address(ep, a);
+		return;
+	case REG:
+		from = a->u.reg;
+		if (reg == SP && r16[from] == 2) {
+			/* LD SP,HL */
+			if (prefix(from))
+				byte(ep, prefix(from));
+			byte(ep, 0xF9);
+			return;
+		}
+		if (from == SP && r16[reg] == 2) {
+			/* LD HL,0; ADD HL,SP */
+			if (pfx)
+				byte(ep, pfx);
+			byte(ep, 0x21);
+			word(ep, 0);
+			if (pfx)
+				byte(ep, pfx);
+			byte(ep, 0x39);
+			return;
+		}
+		/* PASSTROUGH */
+	default:
+		badinst(ep, pc);
+	}
+}
+
+static void
+ld(struct enc *ep, Inst *pc)
+{
+	Addr *to = &pc->to, *from = &pc->from;
+	struct operand dst, src;
+	bool upper = pc->op == LDH;
+	uint8_t reg;
+
+	if (ispair(to)) {
+		ld16(ep, pc);
+		return;
+	}
+
+	if (!operand(to, upper, &dst)) {
+		if (to->kind != MEM || from->kind != REG)
+			badinst(ep, pc);
+		reg = from->u.reg;
+		if (reg == A) {
+			/* LD (nn),A */
+			byte(ep, 0x32);
+		} else if (ispair(from) && r16[reg] == 2) {
+			/* LD (nn),HL */
+			if (prefix(reg))
+				byte(ep, prefix(reg));
+			byte(ep, 0x22);
+		} else if (ispair(from) && reg != AF) {
+			/* LD (nn),rr */
+			byte(ep, 0xED);
+			byte(ep, 0x43 | r16[reg] << 4);
+		} else {
+			badinst(ep, pc);
+		}
+		address(ep, to);
+		return;
+	}
+
+	switch (from->kind) {
+	case CONST:
+		emitop(ep, &dst, 0x06 | dst.code << 3);
+		byte(ep, from->u.i);
+		return;
+	case MEM:
+		/* LD A,(nn) */
+		if (to->kind != REG || to->u.reg != A)
+			badinst(ep, pc);
+		byte(ep, 0x3A);
+		address(ep, from);
+		return;
+	}
+
+	if (!operand(from, upper, &src) ||
+	    (dst.code == 6 && src.code == 6) ||
+	    (dst.pfx && src.pfx && dst.pfx != src.pfx)) {
+		badinst(ep, pc);
+	}
+	if (src.hasdisp) {
+		src.code = src.code | dst.code << 3;
+		emitop(ep, &src, 0x40 | src.code);
+	} else {
+		if (!dst.pfx)
+			dst.pfx = src.pfx;
+		emitop(ep, &dst, 0x40 | dst.code << 3 | src.code);
+	}
+}
+
+/* ADD, ADC, SUB, SBC, AND, XOR, OR and CP use the same encoding */
+static void
+alu(struct enc *ep, Inst *pc, int opcode)
+{
+	Addr *to = &pc->to, *from = &pc->from;
+	struct operand src;
+	uint8_t reg = to->u.reg;
+
+	if (ispair(to)) {
+		if (!ispair(from))
+			badinst(ep, pc);
+		switch (pc->op) {
+		case ADD:
+			if (prefix(reg))
+				byte(ep, prefix(reg));
+			byte(ep, 0x09 | r16[from->u.reg] << 4);
+			return;
+		case ADC:
+		case SBC:
+			if (reg != HL)
+				badinst(ep, pc);
+			byte(ep, 0xED);
+			byte(ep, ((pc->op == ADC) ? 0x4A : 0x42) |
+			         r16[from->u.reg] << 4);
+			return;
+		default:
+			badinst(ep, pc);
+		}
+	}
+
+	if (to->kind != REG || reg != A)
+		badinst(ep, pc);
+	if (from->kind == CONST) {
+		byte(ep, opcode | 0x46);
+		byte(ep, from->u.i);
+		return;
+	}
+	if (!operand(from, 0, &src))
+		badinst(ep, pc);
+	emitop(ep, &src, opcode | src.code);
+}
+
+static void
+incdec(struct enc *ep, Inst *pc)
+{
+	struct operand op;
+	Addr *a = &pc->to;
+	bool dec = pc->op == DEC;
+
+	if (ispair(a)) {
+		if (prefix(a->u.reg))
+			byte(ep, prefix(a->u.reg));
+		byte(ep, (dec ? 0x0B : 0x03) | r16[a->u.reg] << 4);
+		return;
+	}
+	if (!operand(a, 0, &op))
+		badinst(ep, pc);
+	emitop(ep, &op, (dec ? 0x05 : 0x04) | op.code << 3);
+}
+
+static void
+pushpop(struct enc *ep, Inst *pc)
+{
+	Addr *a = (pc->to.kind != NONE) ? &pc->to : &pc->from;
+	uint8_t reg = a->u.reg;
+
+	if (!ispair(a) || reg == SP)
+		badinst(ep, pc);
+	if (prefix(reg))
+		byte(ep, prefix(reg));
+	byte(ep, ((pc->op == PUSH) ? 0xC5 : 0xC1) | r16[reg] << 4);
+}
+
+/* the rotations and shifts of the CB page */
+static void
+rotate(struct enc *ep, Inst *pc, int opcode)
+{
+	struct operand op;
+
+	if (!operand(&pc->to, 0, &op))
+		badinst(ep, pc);
+	if (op.pfx)
+		byte(ep, op.pfx);
+	byte(ep, 0xCB);
+	if (op.hasdisp)
+		byte(ep, op.disp);
+	byte(ep, opcode | op.code);
+}
+
+/* JP nn, JP cc,nn, JP (HL) and CALL nn */
+static void
+jump(struct enc *ep, Inst *pc)
+{
+	Addr *a = &pc->to;
+
+	if (pc->op == CALL)
+		byte(ep, 0xCD);
+	else if (a->kind == INDEX)
+		byte(ep, 0xE9);
+	else if (pc->from.kind == COND)
+		byte(ep, 0xC2 | pc->from.u.i << 3);
+	else
+		byte(ep, 0xC3);
+
+	switch (a->kind) {
+	case LABEL:
+		addfix(&ep->jumps, offset(ep), a->u.sym);
+		word(ep, 0);
+		break;
+	case MEM:
+		address(ep, a);
+		break;
+	case INDEX:
+		if (pc->op == JP && pc->from.kind == NONE)
+			break;
+		/* PASSTROUGH */
+	default:
+		badinst(ep, pc);
+	}
+}
+
+static void
+encode(struct enc *ep, Inst *pc)
+{
+	switch (pc->op) {
+	case LDW:
+	case LDL:
+	case LDH:
+	case LDI:
+	case MOV:
+		ld(ep, pc);
+		break;
+	case ADD:
+		alu(ep, pc, 0x80);
+		break;
+	case ADC:
+		alu(ep, pc, 0x88);
+		break;
+	case SUB:
+		alu(ep, pc, 0x90);
+		break;
+	case SBC:
+		alu(ep, pc, 0x98);
+		break;
+	case AND:
+		alu(ep, pc, 0xA0);
+		break;
+	case XOR:
+		alu(ep, pc, 0xA8);
+		break;
+	case OR:
+		alu(ep, pc, 0xB0);
+		break;
+	case CP:
+		alu(ep, pc, 0xB8);
+		break;
+	case INC:
+	case DEC:
+		incdec(ep, pc);
+		break;
+	case PUSH:
+	case POP:
+		pushpop(ep, pc);
+		break;
+	case JP:
+	case CALL:
+		jump(ep, pc);
+		break;
+	case RR:
+		rotate(ep, pc, 0x18);
+		break;
+	case SRA:
+		rotate(ep, pc, 0x28);
+		break;
+	case SRL:
+		rotate(ep, pc, 0x38);
+		break;
+	case RET:
+		byte(ep, 0xC9);
+		break;
+	case NOP:
+		byte(ep, 0x00);
+		break;
+	case CPL:
+		byte(ep, 0x2F);
+		break;
+	case NEG:
+		byte(ep, 0xED);
+		byte(ep, 0x44);
+		break;
+	default:
+		badinst(ep, pc);
+	}
+}
+
+/* resolve the jumps to the labels of the function */
+static void
+fixjumps(struct enc *ep)
+{
+	struct fixup *jp, *lp, *end;
+	unsigned char *bp;
+	size_t off;
+
+	for (jp = ep->jumps.v; jp < &ep->jumps.v[ep->jumps.n]; ++jp) {
+		end = &ep->labels.v[ep->labels.n];
+		for (lp = ep->labels.v; lp < end && lp->sym != jp->sym; ++lp)
+			;
+		if (lp == end)
+			error(ELABEL);
+		off = lp->off;
+		bp = (unsigned char *) ep->fn->out + ep->base + jp->off;
+		bp[0] = off & 0xFF;
+		bp[1] = off >> 8 & 0xFF;
+		addfix(&ep->relocs, jp->off, ep->fn->sym);
+	}
+}
+
+void
+writeobj(Func *fn)
+{
+	struct enc enc = {.fn = fn}, *ep = &enc;
+	Inst *pc, *end = &fn->prog[fn->ninst];
+	struct fixup *rp;
+	size_t size;
+	unsigned char *bp;
+
+	outname(ep, fn->sym);
+	word(ep, 0);
+	ep->base = fn->outlen;
+
+	for (pc = fn->prog; pc < end; ++pc) {
+		if (pc->label)
+			addfix(&ep->labels, offset(ep), pc->label);
+		encode(ep, pc);
+	}
+	fixjumps(ep);
+
+	size = offset(ep);
+	if (size > 0xFFFF)
+		error(EFUNSIZ);
+	bp = (unsigned char *) fn->out + ep->base - 2;
+	bp[0] = size & 0xFF;
+	bp[1] = size >> 8;
+
+	word(ep, ep->relocs.n);
+	for (rp = ep->relocs.v; rp < &ep->relocs.v[ep->relocs.n]; ++rp) {
+		word(ep, rp->off);
+		outname(ep, rp->sym);
+	}
+
+	xfree(ep->relocs.v);
+	xfree(ep->jumps.v);
+	xfree(ep->labels.v);
+}
+
+/* select the object output, which must be done before any function */
+void
+initobj(void)
+{
+	objout = 1;
+	fputs(OBJMAGIC, stdout);
+}
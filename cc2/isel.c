@@ -0,0 +1,2482 @@
+
+#include <inttypes.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../inc/cc.h"
+#include "cc2.h"
+
+/*
+ * Instruction selection by bottom up rewriting. Every rule of the
+ * table covers an operator with the nonterminals of its children,
+ * or it is a chain rule that converts a nonterminal of a node in
+ * another one. The cost of a rule is given in T-states and bytes,
+ * and the T-states are compared first.
+ *
+ * The labeler visits the tree after the children, and it keeps the
+ * cheapest rule for every nonterminal of every node, trying the
+ * two orders of the commutative operators. The reducer walks the
+ * tree from the goal and emits the code of the chosen rules. After
+ * a node is reduced it describes where its value is: a constant,
+ * a register, a slot of the frame, a global, (HL) or (IY+d).
+ *
+ * A is the accumulator of 8 bits and HL of 16 bits. The values of
+ * 32 bits are computed byte by byte in A from the frame, the
+ * globals and the constants, and they are in DE:HL when they are
+ * returned, passed to a function or used by another operation of
+ * 32 bits. The registers that do not keep variables are used to
+ * save partial results, or the stack when all of them are taken,
+ * and reguse[A] and reguse[HL] remember the variable that was last
+ * stored from them.
+ *
+ * The conditions are NT_CC, a test that leaves the condition in
+ * the flags, and a condition used as a value is c ? 1 : 0. The
+ * Z80 has no multiplication or division, and it only shifts by
+ * one bit, so these operations are calls to the runtime library,
+ * except the shifts of 8 and 16 bits by a constant.
+ *
+ * The selector does not cover everything: the values of 64 bits,
+ * the values of 32 bits through pointers, the structs used as a
+ * whole, the subtraction of an operation of 32 bits, and some
+ * assignments used as values have no rules, and they are reported
+ * with ESELECT.
+ */
+enum {
+	NT_IMM,      /* constant */
+	NT_RV,       /* variable in a register */
+	NT_FRAME,    /* variable in the frame, (IX+d) */
+	NT_ABS,      /* global variable, (nn) */
+	NT_FADDR,    /* address in the frame, IX+d */
+	NT_GADDR,    /* address of a global, nn */
+	NT_IND,      /* value pointed by HL, (HL) */
+	NT_HLP,      /* value pointed by HL, computed in A or HL */
+	NT_SADDR,    /* address computed first and saved in the stack */
+	NT_IY,       /* address in IY */
+	NT_IYD,      /* address IY+d */
+	NT_IDX,      /* value pointed by IY+d, (IY+d) */
+	NT_ACC,      /* value in A, HL or DE:HL */
+	NT_SCR,      /* value saved in a free register */
+	NT_STEP,     /* variable plus or minus 1 */
+	NT_L32,      /* operation of 32 bits over memory */
+	NT_R32,      /* operation of 32 bits over DE:HL */
+	NT_X32,      /* value extended to 32 bits */
+	NT_CC,       /* condition in the flags */
+	NT_STMT,     /* statement */
+	NR_NT
+};
+
+#define NONT NR_NT
+#define INF UINT_MAX
+
+#define S1 1
+#define S2 2
+#define S4 4
+#define S0 8                    /* void */
+#define SX 16                   /* arrays and structs */
+#define S12 (S1|S2)
+#define SALL (S1|S2|S4)
+
+typedef struct sel Sel;
+
+struct rule {
+	uint8_t nt;                 /* nonterminal of the result */
+	uint8_t op;                 /* operator, 0 for chain rules */
+	uint8_t kids[2];            /* nonterminals of the children */
+	uint8_t sizes;              /* sizes of the node */
+	unsigned short t, b;        /* T-states and bytes */
+	bool (*cond)(Sel *, Node *);
+	void (*emit)(Sel *, Node *);
+};
+
+struct cost {
+	unsigned t, b;
+};
+
+struct state {
+	struct cost cost[NR_NT];
+	unsigned short rule[NR_NT];
+	bool swap[NR_NT];
+	bool pushed;                /* the saved value is in the stack */
+};
+
+struct sel {
+	Func *fn;
+	struct state *states;
+	unsigned nstates, maxstates;
+	Node **tmps;                /* nodes made by label() */
+	unsigned ntmps, maxtmps;
+	bool busy[NPAIRS];          /* registers with saved values */
+	bool wide;                  /* DE:HL can have a value */
+};
+
+static uint8_t upper[] = {[DE] = D, [HL] = H, [BC] = B,  [IY] = IYH};
+static uint8_t lower[] = {[DE] = E, [HL] = L, [BC] = C, [IY] = IYL};
+static uint8_t pair[] = {
+	[A] = A,
+	[H] = HL, [L] = HL, [HL] = HL,
+	[B] = BC, [C] = BC, [BC] = BC,
+	[D] = DE, [E] = DE, [DE] = DE,
+	[IYL] = IY, [IYH] = IY, [IY] = IY
+};
+
+/* the functions of the runtime library, see libcall() */
+static Symbol rtlib[] = {
+	{.name = "__mul8"}, {.name = "__mul16"}, {.name = "__mul32"},
+	{.name = "__div8"}, {.name = "__div16"}, {.name = "__div32"},
+	{.name = "__udiv8"}, {.name = "__udiv16"}, {.name = "__udiv32"},
+	{.name = "__mod8"}, {.name = "__mod16"}, {.name = "__mod32"},
+	{.name = "__umod8"}, {.name = "__umod16"}, {.name = "__umod32"},
+	{.name = "__shl8"}, {.name = "__shl16"}, {.name = "__shl32"},
+	{.name = "__shr8"}, {.name = "__shr16"}, {.name = "__shr32"},
+	{.name = "__ushr8"}, {.name = "__ushr16"}, {.name = "__ushr32"}
+};
+
+static void
+fail(Sel *sp)
+{
+	error(ESELECT, sp->fn->sym->name);
+}
+
+static Addr
+areg(uint8_t r)
+{
+	Addr a;
+
+	a.kind = REG;
+	a.off = 0;
+	a.u.reg = r;
+	return a;
+}
+
+static Addr
+aimm(TINT i)
+{
+	Addr a;
+
+	a.kind = CONST;
+	a.off = 0;
+	a.u.i = i;
+	return a;
+}
+
+/* byte i of the value described by the node */
+static Addr
+loc(Sel *sp, Node *np, int i)
+{
+	Addr a;
+	uint8_t r;
+
+	a.off = 0;
+	switch (a.kind = np->op) {
+	case CONST:
+		a.u.i = np->imm >> 8*i & 0xFF;
+		break;
+	case REG:
+		r = np->reg;
+		if (r == HL && i >= 2) {
+			/* the upper word of DE:HL */
+			r = DE;
+			i -= 2;
+		}
+		if (r >= NREGS)
+			r = (i == 0) ? lower[r] : upper[r];
+		else if (i > 0)
+			fail(sp);
+		a.u.reg = r;
+		break;
+	case AUTO:
+	case PAR:
+		a.u.i = np->sym->u.v.off + np->imm + i;
+		break;
+	case INDEXY:
+		a.u.i = np->imm + i;
+		break;
+	case MEM:
+		a.u.sym = np->sym;
+		a.off = np->imm + i;
+		break;
+	case INDEX:
+		/* the caller increments HL */
+		break;
+	default:
+		fail(sp);
+	}
+	return a;
+}
+
+/* the value of 16 bits described by the node */
+static Addr
+loc16(Sel *sp, Node *np)
+{
+	Addr a;
+
+	a.off = 0;
+	switch (a.kind = np->op) {
+	case CONST:
+		a.u.i = np->imm;
+		break;
+	case REG:
+		a.u.reg = np->reg;
+		break;
+	case MEM:
+		a.u.sym = np->sym;
+		a.off = np->imm;
+		break;
+	default:
+		fail(sp);
+	}
+	return a;
+}
+
+/* the instructions that write A or HL forget their variables */
+static void
+inst(Sel *sp, uint8_t op, Addr *to, Addr *from)
+{
+	Func *fn = sp->fn;
+	uint8_t r;
+
+	if (to && to->kind == REG) {
+		r = to->u.reg;
+		if (r == A)
+			fn->reguse[A] = NULL;
+		if (r == H || r == L || r == HL)
+			fn->reguse[HL] = NULL;
+	}
+	inscode(fn, op, to, from);
+}
+
+static void
+move(Sel *sp, Addr to, Addr from)
+{
+	uint8_t op;
+
+	if (to.kind == REG && from.kind == REG)
+		op = MOV;
+	else if (from.kind == CONST)
+		op = LDI;
+	else
+		op = LDL;
+	inst(sp, op, &to, &from);
+}
+
+/* a move of a byte between any places, through A when it is needed */
+static void
+put(Sel *sp, Addr to, Addr from)
+{
+	bool mem = from.kind != REG && from.kind != CONST;
+
+	if (to.kind == REG || from.kind == REG && from.u.reg == A ||
+	    to.kind != MEM && !mem) {
+		move(sp, to, from);
+		return;
+	}
+	move(sp, areg(A), from);
+	move(sp, to, areg(A));
+}
+
+static void
+op1(Sel *sp, uint8_t op, uint8_t reg)
+{
+	Addr a = areg(reg);
+
+	inst(sp, op, &a, NULL);
+}
+
+static void
+op2(Sel *sp, uint8_t op, Addr to, Addr from)
+{
+	inst(sp, op, &to, &from);
+}
+
+static void
+jp(Sel *sp, int cc, Symbol *sym)
+{
+	Addr to, cond;
+
+	to.kind = LABEL;
+	to.off = 0;
+	to.u.sym = sym;
+	cond.kind = COND;
+	cond.u.i = cc;
+	inst(sp, JP, &to, (cc < 0) ? NULL : &cond);
+}
+
+/* the registers can have other values when the label is reached */
+static void
+join(Sel *sp, Symbol *sym)
+{
+	Func *fn = sp->fn;
+
+	deflabel(fn, sym);
+	fn->reguse[A] = fn->reguse[HL] = NULL;
+}
+
+/* byte i of an operand of A, the globals are reached through IY */
+static Addr
+src(Sel *sp, Node *np, int i)
+{
+	Addr a = loc(sp, np, i), iy = areg(IY);
+
+	if (a.kind != MEM)
+		return a;
+	inst(sp, LDI, &iy, &a);
+	a.kind = INDEXY;
+	a.off = 0;
+	a.u.i = 0;
+	return a;
+}
+
+static void
+load16(Sel *sp, uint8_t rr, Node *np)
+{
+	Addr to = areg(rr), from;
+
+	switch (np->op) {
+	case CONST:
+		from = loc16(sp, np);
+		inst(sp, LDI, &to, &from);
+		break;
+	case MEM:
+		from = loc16(sp, np);
+		inst(sp, LDL, &to, &from);
+		break;
+	case REG:
+		if (rr == IY) {
+			from = loc16(sp, np);
+			inst(sp, PUSH, NULL, &from);
+			inst(sp, POP, &to, NULL);
+			break;
+		}
+		/* PASSTHROUGH */
+	case AUTO:
+	case PAR:
+	case INDEXY:
+		if (rr == IY)
+			fail(sp);
+		move(sp, areg(lower[rr]), loc(sp, np, 0));
+		move(sp, areg(upper[rr]), loc(sp, np, 1));
+		break;
+	default:
+		fail(sp);
+	}
+}
+
+static void
+setacc(Node *np)
+{
+	np->op = REG;
+	np->reg = (np->type.size == 1) ? A : HL;
+}
+
+/* the register is the home of a variable, see regalloc.c */
+static bool
+isregvar(Func *fn, uint8_t reg)
+{
+	return fn->varregs[reg] || fn->varregs[pair[reg]] ||
+	       reg >= NREGS && (fn->varregs[upper[reg]] ||
+	                        fn->varregs[lower[reg]]);
+}
+
+/* the register keeps a variable or a saved value */
+static bool
+busyreg(Sel *sp, uint8_t reg)
+{
+	return isregvar(sp->fn, reg) || sp->busy[reg] ||
+	       sp->busy[upper[reg]] || sp->busy[lower[reg]];
+}
+
+static bool
+isfree(Sel *sp, uint8_t reg)
+{
+	if (isregvar(sp->fn, reg) || sp->busy[reg] || sp->busy[pair[reg]])
+		return 0;
+	if (sp->wide && pair[reg] == DE)
+		return 0;
+	return reg < NREGS || !sp->busy[upper[reg]] && !sp->busy[lower[reg]];
+}
+
+static uint8_t
+scratch(Sel *sp, unsigned size)
+{
+	static uint8_t reg8[] = {E, D, C, B, 0};
+	static uint8_t reg16[] = {DE, BC, 0};
+	uint8_t *bp, r;
+
+	for (bp = (size == 1) ? reg8 : reg16; r = *bp; ++bp) {
+		if (isfree(sp, r)) {
+			sp->busy[r] = 1;
+			return r;
+		}
+	}
+	return 0;
+}
+
+static void
+forget(Sel *sp, Symbol *sym)
+{
+	Node **reguse = sp->fn->reguse;
+
+	if (reguse[A] && reguse[A]->sym == sym)
+		reguse[A] = NULL;
+	if (reguse[HL] && reguse[HL]->sym == sym)
+		reguse[HL] = NULL;
+}
+
+static uint8_t
+aluop(Sel *sp, int op)
+{
+	switch (op) {
+	case OADD:
+		return ADD;
+	case OSUB:
+		return SUB;
+	case OBAND:
+		return AND;
+	case OBOR:
+		return OR;
+	case OBXOR:
+		return XOR;
+	default:
+		fail(sp);
+		return NOP;
+	}
+}
+
+/*
+ * The conditions are checked before the casts are reduced, so
+ * they look at the node under the casts
+ */
+static Node *
+leaf(Node *np)
+{
+	while (np->op == OCAST)
+		np = np->left;
+	return np;
+}
+
+static bool
+cached(Sel *sp, Node *np)
+{
+	Node *u = sp->fn->reguse[(np->type.size == 1) ? A : HL];
+	Node *lp = leaf(np);
+
+	return lp->sym && u && u->sym == lp->sym && u->imm == lp->imm;
+}
+
+static bool
+zero(Sel *sp, Node *np)
+{
+	return (leaf(np)->imm & 0xFF) == 0;
+}
+
+/* the right operand is the constant 1 */
+static bool
+one(Sel *sp, Node *np)
+{
+	Node *rp = leaf(np->right);
+
+	return rp->op == CONST && rp->imm == 1;
+}
+
+/* the right operand is a constant from 1 to 4 */
+static bool
+small(Sel *sp, Node *np)
+{
+	Node *rp = leaf(np->right);
+
+	return rp->op == CONST && rp->imm >= 1 && rp->imm <= 4;
+}
+
+static bool
+disp(Sel *sp, Node *np)
+{
+	TINT d = leaf(np->right)->imm;
+
+	return d >= -128 && d <= 127;
+}
+
+/* there is a pair that can save a value */
+static bool
+spare(Sel *sp, Node *np)
+{
+	return !isregvar(sp->fn, DE) && !sp->wide || !isregvar(sp->fn, BC);
+}
+
+/* DE is free for the upper word of a value of 32 bits */
+static bool
+dehl(Sel *sp, Node *np)
+{
+	return np->type.size != 4 || !isregvar(sp->fn, DE);
+}
+
+/* a comparison with 0 that only needs the sign or a test */
+static bool
+nil(Sel *sp, Node *np)
+{
+	Node *rp = leaf(np->right);
+
+	if (rp->op != CONST || rp->imm != 0)
+		return 0;
+	return np->op == OEQ || np->op == ONE || (np->type.flags & SIGNF);
+}
+
+static bool
+narrow(Sel *sp, Node *np)
+{
+	return np->type.size <= np->left->type.size;
+}
+
+static bool
+samesize(Sel *sp, Node *np)
+{
+	return np->type.size == np->left->type.size;
+}
+
+static bool
+shorter(Sel *sp, Node *np)
+{
+	return np->type.size < np->left->type.size;
+}
+
+static bool
+wider(Sel *sp, Node *np)
+{
+	return np->type.size > np->left->type.size;
+}
+
+static bool
+zext(Sel *sp, Node *np)
+{
+	return np->left->type.size == 1 && !(np->left->type.flags & SIGNF);
+}
+
+static bool
+sext(Sel *sp, Node *np)
+{
+	return np->left->type.size == 1 && (np->left->type.flags & SIGNF);
+}
+
+/* x = x + 1 */
+static bool
+same(Sel *sp, Node *np)
+{
+	Node *lp = leaf(np->left), *rp = leaf(np->right->left);
+
+	return lp->sym && lp->op == rp->op && lp->sym == rp->sym &&
+	       lp->imm == rp->imm;
+}
+
+/* the location of a node is the location of its child */
+static void
+pass(Sel *sp, Node *np)
+{
+	Node *lp = np->left;
+
+	np->op = lp->op;
+	np->subop = lp->subop;
+	np->reg = lp->reg;
+	np->sym = lp->sym;
+	np->imm = lp->imm;
+	if (np->op == REG && np->reg >= NREGS && np->type.size == 1)
+		np->reg = lower[np->reg];
+	if (np->op == CONST && np->type.size < 4)
+		np->imm &= (1L << 8*np->type.size) - 1;
+}
+
+static void
+load(Sel *sp, Node *np)
+{
+	bool var = np->op == REG || np->op == AUTO || np->op == PAR ||
+	           np->op == MEM;
+
+	if (np->type.size == 1)
+		move(sp, areg(A), loc(sp, np, 0));
+	else
+		load16(sp, HL, np);
+	setacc(np);
+	if (var && np->sym)
+		sp->fn->reguse[np->reg] = np;
+}
+
+/* the value can be already in the accumulator */
+static void
+reuse(Sel *sp, Node *np)
+{
+	if (cached(sp, np))
+		setacc(np);
+	else
+		load(sp, np);
+}
+
+static void
+clra(Sel *sp, Node *np)
+{
+	op2(sp, XOR, areg(A), areg(A));
+	setacc(np);
+}
+
+/* the address of a variable, IX+d or nn */
+static void
+addrof(Sel *sp, Node *np)
+{
+	Node *lp = np->left;
+
+	np->subop = lp->op;
+	np->sym = lp->sym;
+	np->imm = lp->imm;
+}
+
+/* an address plus a constant is another address */
+static void
+offset(Sel *sp, Node *np)
+{
+	Node *lp = np->left;
+
+	np->op = OADDR;
+	np->subop = lp->subop;
+	np->sym = lp->sym;
+	np->imm = lp->imm + np->right->imm;
+}
+
+/* the value at a known address is a variable */
+static void
+deref(Sel *sp, Node *np)
+{
+	Node *lp = np->left;
+
+	np->op = lp->subop;
+	np->sym = lp->sym;
+	np->imm = lp->imm;
+}
+
+/* an address of the frame or of a global in HL */
+static void
+ldaddr(Sel *sp, Node *np)
+{
+	Addr hl = areg(HL), a;
+	TINT d;
+
+	if (np->subop == MEM) {
+		a.kind = MEM;
+		a.u.sym = np->sym;
+		a.off = np->imm;
+		inst(sp, LDI, &hl, &a);
+	} else {
+		a = areg(IX);
+		inst(sp, PUSH, NULL, &a);
+		inst(sp, POP, &hl, NULL);
+		d = (TINT) np->sym->u.v.off + np->imm;
+		if (d >= -4 && d <= 4) {
+			for (; d < 0; ++d)
+				op1(sp, DEC, HL);
+			for (; d > 0; --d)
+				op1(sp, INC, HL);
+		} else {
+			move(sp, areg(A), areg(L));
+			op2(sp, ADD, areg(A), aimm(d & 0xFF));
+			move(sp, areg(L), areg(A));
+			move(sp, areg(A), areg(H));
+			op2(sp, ADC, areg(A), aimm(d >> 8 & 0xFF));
+			move(sp, areg(H), areg(A));
+		}
+	}
+	setacc(np);
+}
+
+/* HL plus the address of a global, DE is saved when no pair is free */
+static void
+addaddr(Sel *sp, Node *np)
+{
+	Node *rp = np->right;
+	uint8_t r = scratch(sp, 2);
+	Addr hl = areg(HL), rr = areg((r) ? r : DE), a;
+
+	if (!r)
+		inst(sp, PUSH, NULL, &rr);
+	a.kind = MEM;
+	a.off = rp->imm;
+	a.u.sym = rp->sym;
+	inst(sp, LDI, &rr, &a);
+	inst(sp, ADD, &hl, &rr);
+	if (!r)
+		inst(sp, POP, &rr, NULL);
+	sp->busy[r] = 0;
+	setacc(np);
+}
+
+static void
+ind(Sel *sp, Node *np)
+{
+	Addr a = areg(HL), sym = loc16(sp, np);
+
+	inst(sp, LDI, &a, &sym);
+	np->op = INDEX;
+}
+
+static void
+indptr(Sel *sp, Node *np)
+{
+	load16(sp, HL, np->left);
+	np->op = INDEX;
+}
+
+/* the address is already in HL */
+static void
+hlptr(Sel *sp, Node *np)
+{
+	np->op = INDEX;
+}
+
+/* the address is saved, and the store takes it in IY, see popaddr() */
+static void
+pushaddr(Sel *sp, Node *np)
+{
+	Addr hl = areg(HL);
+
+	inst(sp, PUSH, NULL, &hl);
+	np->op = INDEXY;
+	np->imm = 0;
+}
+
+static void
+iy(Sel *sp, Node *np)
+{
+	Addr a = areg(IY), sym;
+
+	if (np->op == OADDR) {
+		sym.kind = MEM;
+		sym.off = np->imm;
+		sym.u.sym = np->sym;
+		inst(sp, LDI, &a, &sym);
+	} else {
+		load16(sp, IY, np);
+	}
+	np->op = REG;
+	np->reg = IY;
+}
+
+static void
+iyd(Sel *sp, Node *np)
+{
+	np->imm = (np->op == OADD) ? np->right->imm : 0;
+	np->op = INDEXY;
+}
+
+static void
+idx(Sel *sp, Node *np)
+{
+	np->op = INDEXY;
+	np->imm = np->left->imm;
+}
+
+static void
+accptr(Sel *sp, Node *np)
+{
+	Addr a = areg(A), hl = {.kind = INDEX};
+
+	inst(sp, LDL, &a, &hl);
+	if (np->type.size == 2) {
+		op1(sp, INC, HL);
+		op2(sp, LDL, areg(H), hl);
+		op2(sp, MOV, areg(L), areg(A));
+	}
+	setacc(np);
+}
+
+static void
+alu(Sel *sp, Node *np)
+{
+	op2(sp, aluop(sp, np->op), areg(A), loc(sp, np->right, 0));
+	setacc(np);
+}
+
+static void
+incacc(Sel *sp, Node *np)
+{
+	op1(sp, (np->op == OADD) ? INC : DEC, (np->type.size == 1) ? A : HL);
+	setacc(np);
+}
+
+static void
+cpl(Sel *sp, Node *np)
+{
+	op1(sp, (np->op == OCPL) ? CPL : NEG, A);
+	setacc(np);
+}
+
+/*
+ * Shifts by a constant. The Z80 only shifts by one bit, but the
+ * shifts of 8 bits or more of a pair move a byte
+ */
+static void
+shift(Sel *sp, Node *np)
+{
+	TINT k = np->right->imm, bits = 8 * np->type.size;
+	bool sign = np->type.flags & SIGNF;
+	uint8_t sh = (sign) ? SRA : SRL;
+
+	if (k < 0 || k >= bits) {
+		if (np->op == OSHL || !sign) {
+			move(sp, areg((bits == 8) ? A : HL), aimm(0));
+			setacc(np);
+			return;
+		}
+		k = bits - 1;
+	}
+
+	if (bits == 8) {
+		while (k-- > 0) {
+			if (np->op == OSHL)
+				op2(sp, ADD, areg(A), areg(A));
+			else
+				op1(sp, sh, A);
+		}
+	} else if (np->op == OSHL) {
+		if (k >= 8) {
+			move(sp, areg(H), areg(L));
+			move(sp, areg(L), aimm(0));
+			k -= 8;
+		}
+		while (k-- > 0)
+			op2(sp, ADD, areg(HL), areg(HL));
+	} else {
+		if (k >= 8) {
+			move(sp, areg(L), areg(H));
+			if (sign) {
+				move(sp, areg(A), areg(H));
+				op2(sp, ADD, areg(A), areg(A));
+				op2(sp, SBC, areg(A), areg(A));
+				move(sp, areg(H), areg(A));
+			} else {
+				move(sp, areg(H), aimm(0));
+			}
+			k -= 8;
+		}
+		while (k-- > 0) {
+			op1(sp, sh, H);
+			op1(sp, RR, L);
+		}
+	}
+	setacc(np);
+}
+
+/* save the value of the accumulator */
+static void
+save(Sel *sp, Node *np)
+{
+	uint8_t r;
+
+	if ((r = scratch(sp, np->type.size)) != 0) {
+		if (np->type.size == 1) {
+			move(sp, areg(r), areg(A));
+		} else {
+			move(sp, areg(lower[r]), areg(L));
+			move(sp, areg(upper[r]), areg(H));
+		}
+	} else if (np->type.size == 1) {
+		op2(sp, PUSH, (Addr) {.kind = NONE}, areg(AF));
+		sp->states[np->state].pushed = 1;
+		r = H;
+	} else {
+		op2(sp, PUSH, (Addr) {.kind = NONE}, areg(HL));
+		sp->states[np->state].pushed = 1;
+		r = 0;
+	}
+	np->op = REG;
+	np->reg = r;
+}
+
+static void
+scrload(Sel *sp, Node *np)
+{
+	uint8_t r;
+
+	if ((r = scratch(sp, 2)) == 0)
+		fail(sp);
+	load16(sp, r, np);
+	np->op = REG;
+	np->reg = r;
+}
+
+static void
+add16(Sel *sp, Node *np)
+{
+	op2(sp, ADD, areg(HL), loc16(sp, np->right));
+	setacc(np);
+}
+
+static void
+sub16(Sel *sp, Node *np)
+{
+	op2(sp, OR, areg(A), areg(A));
+	op2(sp, SBC, areg(HL), loc16(sp, np->right));
+	setacc(np);
+}
+
+/* byte by byte in A, with the carry of the low byte */
+static void
+bytes16(Sel *sp, Node *np)
+{
+	uint8_t op = aluop(sp, np->op);
+
+	move(sp, areg(A), areg(L));
+	op2(sp, op, areg(A), loc(sp, np->right, 0));
+	move(sp, areg(L), areg(A));
+	move(sp, areg(A), areg(H));
+	if (op == ADD || op == SUB)
+		op = (op == ADD) ? ADC : SBC;
+	op2(sp, op, areg(A), loc(sp, np->right, 1));
+	move(sp, areg(H), areg(A));
+	setacc(np);
+}
+
+static void
+cpl16(Sel *sp, Node *np)
+{
+	move(sp, areg(A), areg(L));
+	op1(sp, CPL, A);
+	move(sp, areg(L), areg(A));
+	move(sp, areg(A), areg(H));
+	op1(sp, CPL, A);
+	move(sp, areg(H), areg(A));
+	setacc(np);
+}
+
+/* 0 - HL, with the borrow of the low byte */
+static void
+neg16(Sel *sp, Node *np)
+{
+	op2(sp, XOR, areg(A), areg(A));
+	op2(sp, SUB, areg(A), areg(L));
+	move(sp, areg(L), areg(A));
+	op2(sp, SBC, areg(A), areg(A));
+	op2(sp, SUB, areg(A), areg(H));
+	move(sp, areg(H), areg(A));
+	setacc(np);
+}
+
+/* the value of a comma is the value of its right side */
+static void
+comma(Sel *sp, Node *np)
+{
+	setacc(np);
+}
+
+static void
+low(Sel *sp, Node *np)
+{
+	move(sp, areg(A), areg(L));
+	setacc(np);
+}
+
+static void
+ext(Sel *sp, Node *np)
+{
+	move(sp, areg(L), areg(A));
+	if (np->left->type.flags & SIGNF) {
+		op2(sp, ADD, areg(A), areg(A));
+		op2(sp, SBC, areg(A), areg(A));
+		move(sp, areg(H), areg(A));
+	} else {
+		move(sp, areg(H), aimm(0));
+	}
+	setacc(np);
+}
+
+static void
+store16(Sel *sp, Node *lp, Node *rp)
+{
+	Addr to, from;
+
+	if (lp->op == INDEX) {
+		/* (HL) has no displacement */
+		to = loc(sp, lp, 0);
+		move(sp, to, loc(sp, rp, 0));
+		op1(sp, INC, HL);
+		move(sp, to, loc(sp, rp, 1));
+	} else if (lp->op == MEM || rp->op == MEM ||
+	           lp->op == REG && rp->op == CONST) {
+		to = loc16(sp, lp);
+		from = loc16(sp, rp);
+		inst(sp, (rp->op == CONST) ? LDI : LDL, &to, &from);
+	} else {
+		move(sp, loc(sp, lp, 0), loc(sp, rp, 0));
+		move(sp, loc(sp, lp, 1), loc(sp, rp, 1));
+	}
+}
+
+static void
+store(Sel *sp, Node *np)
+{
+	Node *lp = np->left, *rp = np->right;
+	Func *fn = sp->fn;
+	uint8_t acc = (np->type.size == 1) ? A : HL;
+
+	if (np->type.size == 1)
+		move(sp, loc(sp, lp, 0), loc(sp, rp, 0));
+	else
+		store16(sp, lp, rp);
+
+	if (lp->op == INDEX || lp->op == INDEXY) {
+		/* the pointer can point to any variable */
+		fn->reguse[A] = fn->reguse[HL] = NULL;
+	} else {
+		forget(sp, lp->sym);
+		if (rp->op == REG && rp->reg == acc)
+			fn->reguse[acc] = lp;
+	}
+	np->op = rp->op;
+	np->reg = rp->reg;
+	np->sym = rp->sym;
+	np->imm = rp->imm;
+}
+
+/* the store through an address saved by pushaddr() */
+static void
+popaddr(Sel *sp, Node *np)
+{
+	Addr a = areg(IY);
+
+	inst(sp, POP, &a, NULL);
+	store(sp, np);
+}
+
+static void
+step(Sel *sp, Node *np)
+{
+	Node *lp = np->left;
+	uint8_t op = (np->right->op == OADD) ? INC : DEC;
+	Addr a, hl = {.kind = INDEX};
+
+	switch (lp->op) {
+	case REG:
+		op1(sp, op, lp->reg);
+		break;
+	case AUTO:
+	case PAR:
+		a = loc(sp, lp, 0);
+		inst(sp, op, &a, NULL);
+		break;
+	case MEM:
+		a = loc16(sp, lp);
+		op2(sp, LDI, areg(HL), a);
+		inst(sp, op, &hl, NULL);
+		break;
+	default:
+		fail(sp);
+	}
+	forget(sp, lp->sym);
+}
+
+/* x++ used as a value, the old value stays in the accumulator */
+static void
+postinc(Sel *sp, Node *np)
+{
+	Node *lp = np->left, hl = {.op = REG, .reg = HL};
+	uint8_t op = (np->subop == OADD) ? INC : DEC;
+	TINT i, k = np->right->imm;
+	Addr a, ptr = {.kind = INDEX};
+
+	if (np->type.size == 1) {
+		move(sp, areg(A), loc(sp, lp, 0));
+		if (lp->op == MEM) {
+			a = loc16(sp, lp);
+			op2(sp, LDI, areg(HL), a);
+			a = ptr;
+		} else {
+			a = loc(sp, lp, 0);
+		}
+		for (i = 0; i < k; ++i)
+			inst(sp, op, &a, NULL);
+	} else {
+		load16(sp, HL, lp);
+		if (lp->op == REG) {
+			for (i = 0; i < k; ++i)
+				op1(sp, op, lp->reg);
+		} else {
+			for (i = 0; i < k; ++i)
+				op1(sp, op, HL);
+			store16(sp, lp, &hl);
+			for (i = 0; i < k; ++i)
+				op1(sp, (op == INC) ? DEC : INC, HL);
+		}
+	}
+	forget(sp, lp->sym);
+	setacc(np);
+}
+
+/* byte i of a value of 32 bits, in A */
+static void
+byte32(Sel *sp, Node *np, int i)
+{
+	Node *lp = np->left;
+	unsigned size;
+	uint8_t op;
+
+	switch (np->op) {
+	case OADD:
+	case OSUB:
+		op = aluop(sp, np->op);
+		if (i > 0)
+			op = (op == ADD) ? ADC : SBC;
+		goto binary;
+	case OBAND:
+	case OBOR:
+	case OBXOR:
+		op = aluop(sp, np->op);
+	binary:
+		move(sp, areg(A), loc(sp, lp, i));
+		op2(sp, op, areg(A), src(sp, np->right, i));
+		break;
+	case OCPL:
+		move(sp, areg(A), loc(sp, lp, i));
+		op1(sp, CPL, A);
+		break;
+	case ONEG:
+		if (i == 0) {
+			op2(sp, XOR, areg(A), areg(A));
+			op2(sp, SUB, areg(A), src(sp, lp, 0));
+		} else {
+			move(sp, areg(A), aimm(0));
+			op2(sp, SBC, areg(A), src(sp, lp, i));
+		}
+		break;
+	case OCAST:
+		size = lp->type.size;
+		if (i < size) {
+			move(sp, areg(A), loc(sp, lp, i));
+		} else if (lp->type.flags & SIGNF) {
+			move(sp, areg(A), loc(sp, lp, size-1));
+			op2(sp, ADD, areg(A), areg(A));
+			op2(sp, SBC, areg(A), areg(A));
+		} else {
+			move(sp, areg(A), aimm(0));
+		}
+		break;
+	default:
+		move(sp, areg(A), loc(sp, np, i));
+		break;
+	}
+}
+
+static void
+store32(Sel *sp, Node *np)
+{
+	Node *lp = np->left, *rp = np->right;
+	Addr to, from;
+	int i;
+
+	if (lp->op == MEM && (rp->op == REG || rp->op == CONST)) {
+		/* LD (nn),HL and LD (nn),DE */
+		for (i = 0; i < 4; i += 2) {
+			to = loc16(sp, lp);
+			to.off += i;
+			if (rp->op == CONST) {
+				move(sp, areg(HL), aimm(rp->imm >> 8*i & 0xFFFF));
+				from = areg(HL);
+			} else {
+				from = areg((i == 0) ? HL : DE);
+			}
+			inst(sp, LDL, &to, &from);
+		}
+		forget(sp, lp->sym);
+		return;
+	}
+
+	for (i = 0; i < 4; ++i) {
+		if (rp->op == CONST || rp->op == REG) {
+			put(sp, loc(sp, lp, i), loc(sp, rp, i));
+		} else {
+			byte32(sp, rp, i);
+			put(sp, loc(sp, lp, i), areg(A));
+		}
+		if (lp->op == INDEX && i < 3)
+			op1(sp, INC, HL);
+	}
+	if (lp->op == INDEX || lp->op == INDEXY)
+		sp->fn->reguse[A] = sp->fn->reguse[HL] = NULL;
+	else
+		forget(sp, lp->sym);
+}
+
+/* a value of 32 bits in DE:HL */
+static void
+load32(Sel *sp, Node *np)
+{
+	Addr to, from;
+	int i;
+
+	for (i = 0; i < 4; i += 2) {
+		to = areg((i == 0) ? HL : DE);
+		if (np->op == CONST) {
+			move(sp, to, aimm(np->imm >> 8*i & 0xFFFF));
+		} else if (np->op == MEM) {
+			from = loc16(sp, np);
+			from.off += i;
+			inst(sp, LDL, &to, &from);
+		} else {
+			move(sp, areg(lower[to.u.reg]), loc(sp, np, i));
+			move(sp, areg(upper[to.u.reg]), loc(sp, np, i+1));
+		}
+	}
+	setacc(np);
+}
+
+static void
+acc32(Sel *sp, Node *np)
+{
+	static uint8_t regs[] = {L, H, E, D};
+	int i;
+
+	for (i = 0; i < 4; ++i) {
+		byte32(sp, np, i);
+		move(sp, areg(regs[i]), areg(A));
+	}
+	setacc(np);
+}
+
+/* the low bytes of a value of 32 bits */
+static void
+low32(Sel *sp, Node *np)
+{
+	Node *lp = np->left;
+
+	byte32(sp, lp, 0);
+	if (np->type.size == 2) {
+		move(sp, areg(L), areg(A));
+		byte32(sp, lp, 1);
+		move(sp, areg(H), areg(A));
+	}
+	setacc(np);
+}
+
+/*
+ * The sign of a subtraction is wrong when it overflows, and then
+ * it is inverted in the sign of A, which takes the upper byte
+ */
+static void
+fixsign(Sel *sp, uint8_t r)
+{
+	Symbol *ok = newlabel(sp->fn);
+
+	jp(sp, CCPO, ok);
+	if (r != A)
+		move(sp, areg(A), areg(r));
+	op2(sp, XOR, areg(A), aimm(0x80));
+	deflabel(sp->fn, ok);
+}
+
+/* the condition of a comparison, after a subtraction */
+static void
+setcc(Node *np, bool sign)
+{
+	switch (np->op) {
+	case OEQ:
+		np->subop = CCZ;
+		break;
+	case ONE:
+		np->subop = CCNZ;
+		break;
+	case OLT:
+		np->subop = (sign) ? CCM : CCC;
+		break;
+	default:
+		np->subop = (sign) ? CCP : CCNC;
+		break;
+	}
+}
+
+/* x op 0 */
+static void
+test(Sel *sp, Node *np)
+{
+	Node *lp = np->left;
+	bool eq = np->op == OEQ || np->op == ONE;
+	int i, n = np->type.size;
+
+	if (n == 1) {
+		op2(sp, OR, areg(A), areg(A));
+	} else if (!eq) {
+		move(sp, areg(A), loc(sp, lp, n-1));
+		op2(sp, OR, areg(A), areg(A));
+	} else {
+		move(sp, areg(A), loc(sp, lp, 0));
+		for (i = 1; i < n; ++i)
+			op2(sp, OR, areg(A), src(sp, lp, i));
+	}
+	setcc(np, 1);
+}
+
+/* comparisons of 8 bits, x in A */
+static void
+cmp8(Sel *sp, Node *np)
+{
+	Node *rp = np->right;
+	bool sign = np->type.flags & SIGNF;
+
+	if (np->op == OEQ || np->op == ONE || !sign) {
+		op2(sp, CP, areg(A), loc(sp, rp, 0));
+		setcc(np, 0);
+	} else if (rp->op == CONST) {
+		/* the signed order is the unsigned one with the sign flipped */
+		op2(sp, XOR, areg(A), aimm(0x80));
+		op2(sp, CP, areg(A), aimm(rp->imm & 0xFF ^ 0x80));
+		setcc(np, 0);
+	} else {
+		op2(sp, SUB, areg(A), loc(sp, rp, 0));
+		fixsign(sp, A);
+		setcc(np, 1);
+	}
+}
+
+/* comparisons of 16 bits, x in HL and y in a pair */
+static void
+cmp16(Sel *sp, Node *np)
+{
+	bool sign = np->type.flags & SIGNF;
+	bool eq = np->op == OEQ || np->op == ONE;
+
+	op2(sp, OR, areg(A), areg(A));
+	op2(sp, SBC, areg(HL), loc16(sp, np->right));
+	if (sign && !eq)
+		fixsign(sp, H);
+	setcc(np, sign && !eq);
+}
+
+/* comparisons byte by byte in A, with HL or DE:HL in any side */
+static void
+bytecmp(Sel *sp, Node *np)
+{
+	Node *lp = np->left, *rp = np->right;
+	bool sign = np->type.flags & SIGNF;
+	int i, n = np->type.size;
+
+	if (np->op == OEQ || np->op == ONE) {
+		for (i = 0; i < n; ++i) {
+			move(sp, areg(A), loc(sp, lp, i));
+			op2(sp, XOR, areg(A), src(sp, rp, i));
+			if (i > 0)
+				op2(sp, OR, areg(A), areg(L));
+			if (i < n-1)
+				move(sp, areg(L), areg(A));
+		}
+		setcc(np, 0);
+		return;
+	}
+	for (i = 0; i < n; ++i) {
+		move(sp, areg(A), loc(sp, lp, i));
+		op2(sp, (i == 0) ? SUB : SBC, areg(A), src(sp, rp, i));
+	}
+	if (sign)
+		fixsign(sp, A);
+	setcc(np, sign);
+}
+
+/* the value of a test, when it is not a comparison */
+static void
+nz(Sel *sp, Node *np)
+{
+	int i, n = np->type.size;
+
+	if (n == 1) {
+		op2(sp, OR, areg(A), areg(A));
+	} else {
+		move(sp, areg(A), loc(sp, np, 0));
+		for (i = 1; i < n; ++i)
+			op2(sp, OR, areg(A), loc(sp, np, i));
+	}
+	np->subop = CCNZ;
+}
+
+static bool
+iscond(Node *np)
+{
+	switch (np->op) {
+	case OLT:
+	case OGT:
+	case OLE:
+	case OGE:
+	case OEQ:
+	case ONE:
+	case OAND:
+	case OOR:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+/* c ? 1 : 0, as made by boolval() */
+static bool
+isboolval(Node *np)
+{
+	Node *colon = np->right;
+
+	return np->op == OASK &&
+	       colon->left->op == CONST && colon->left->imm == 1 &&
+	       colon->right->op == CONST && colon->right->imm == 0;
+}
+
+static void reduce(Sel *sp, Node *np, int nt);
+
+/* jump to the label when the condition is iftrue */
+static void
+branch(Sel *sp, Node *np, Symbol *label, bool iftrue)
+{
+	Node *lp = np->left, *rp = np->right;
+	Symbol *skip;
+	int cc;
+
+	switch (np->op) {
+	case OCOMMA:
+		reduce(sp, lp, NT_STMT);
+		branch(sp, rp, label, iftrue);
+		return;
+	case OASK:
+		if (isboolval(np)) {
+			branch(sp, lp, label, iftrue);
+			return;
+		}
+		break;
+	case OAND:
+	case OOR:
+		if ((np->op == OAND) == iftrue) {
+			skip = newlabel(sp->fn);
+			branch(sp, lp, skip, !iftrue);
+			branch(sp, rp, label, iftrue);
+			join(sp, skip);
+		} else {
+			branch(sp, lp, label, iftrue);
+			branch(sp, rp, label, iftrue);
+		}
+		return;
+	case OEQ:
+	case ONE:
+		/* (c ? 1 : 0) == 0 is !c */
+		if (isboolval(lp) && rp->op == CONST && rp->imm == 0) {
+			branch(sp, lp->left, label, iftrue ^ (np->op == OEQ));
+			return;
+		}
+		break;
+	}
+	reduce(sp, np, NT_CC);
+	cc = np->subop;
+	jp(sp, (iftrue) ? cc : cc ^ 1, label);
+}
+
+/* c ? a : b, with the value in the accumulator */
+static void
+ask(Sel *sp, Node *np)
+{
+	Node *colon = np->right;
+	Symbol *no = newlabel(sp->fn), *end = newlabel(sp->fn);
+
+	branch(sp, np->left, no, 0);
+	reduce(sp, colon->left, NT_ACC);
+	jp(sp, -1, end);
+	join(sp, no);
+	reduce(sp, colon->right, NT_ACC);
+	join(sp, end);
+	setacc(np);
+}
+
+/*
+ * The arguments are pushed from the last one, and every one takes
+ * a multiple of 2 bytes, as paramdcl() of parser.c expects. The
+ * caller removes them after the call. The value is returned in A,
+ * HL or DE:HL, and the function can change all the registers but
+ * IX, so the caller saves BC and DE when they have a variable or a
+ * partial result. The functions of the runtime library take their
+ * operands in the same way.
+ */
+static unsigned
+pushargs(Sel *sp, Node *par)
+{
+	Node *np;
+	struct state *st;
+	unsigned n;
+	Addr hl = areg(HL), de = areg(DE), rr;
+
+	if (!par)
+		return 0;
+	n = pushargs(sp, par->right);
+	np = par->left;
+	st = &sp->states[np->state];
+
+	switch (par->type.size) {
+	case 1:
+		reduce(sp, np, NT_ACC);
+		move(sp, areg(L), areg(A));
+		inst(sp, PUSH, NULL, &hl);
+		return n + 1;
+	case 2:
+		if (st->cost[NT_RV].t != INF) {
+			reduce(sp, np, NT_RV);
+			rr = loc16(sp, np);
+		} else {
+			reduce(sp, np, NT_ACC);
+			rr = hl;
+		}
+		inst(sp, PUSH, NULL, &rr);
+		return n + 1;
+	case 4:
+		reduce(sp, np, NT_ACC);
+		inst(sp, PUSH, NULL, &de);
+		inst(sp, PUSH, NULL, &hl);
+		return n + 2;
+	default:
+		fail(sp);
+		return n;
+	}
+}
+
+static void
+call(Sel *sp, Node *np)
+{
+	Func *fn = sp->fn;
+	Node *fp = np->left;
+	static uint8_t pairs[] = {BC, DE};
+	uint8_t saved[2];
+	int i, n = 0;
+	unsigned words, size = np->type.size;
+	Symbol *thunk, *back;
+	Addr a, sp16 = areg(SP), iy = areg(IY);
+
+	for (i = 0; i < 2; ++i) {
+		if (!busyreg(sp, pairs[i]))
+			continue;
+		if (pairs[i] == DE && size == 4)
+			fail(sp);
+		a = areg(pairs[i]);
+		inst(sp, PUSH, NULL, &a);
+		saved[n++] = pairs[i];
+	}
+
+	words = pushargs(sp, np->right);
+	switch (fp->op) {
+	case MEM:
+		a = loc16(sp, fp);
+		inst(sp, CALL, &a, NULL);
+		break;
+	case OPTR:
+		/* CALL to a JP (HL) */
+		reduce(sp, fp->left, NT_ACC);
+		thunk = newlabel(fn);
+		back = newlabel(fn);
+		a.kind = LABEL;
+		a.off = 0;
+		a.u.sym = thunk;
+		inst(sp, CALL, &a, NULL);
+		jp(sp, -1, back);
+		deflabel(fn, thunk);
+		a.kind = INDEX;
+		inst(sp, JP, &a, NULL);
+		deflabel(fn, back);
+		break;
+	default:
+		fail(sp);
+	}
+
+	if (words > 4) {
+		move(sp, iy, aimm(2*words));
+		op2(sp, ADD, iy, sp16);
+		op2(sp, MOV, sp16, iy);
+	} else {
+		a = areg((size == 1) ? HL : AF);
+		while (words-- > 0)
+			inst(sp, POP, &a, NULL);
+	}
+	while (n-- > 0) {
+		a = areg(saved[n]);
+		inst(sp, POP, &a, NULL);
+	}
+	fn->reguse[A] = fn->reguse[HL] = NULL;
+	if (size > 0)
+		setacc(np);
+}
+
+#define ALU8(op) \
+	{NT_ACC, op, {NT_ACC, NT_IMM}, S1, 7, 2, NULL, alu}, \
+	{NT_ACC, op, {NT_ACC, NT_RV}, S1, 4, 1, NULL, alu}, \
+	{NT_ACC, op, {NT_ACC, NT_FRAME}, S1, 19, 3, NULL, alu}, \
+	{NT_ACC, op, {NT_ACC, NT_IND}, S1, 7, 1, NULL, alu}, \
+	{NT_ACC, op, {NT_ACC, NT_IDX}, S1, 19, 3, NULL, alu}, \
+	{NT_ACC, op, {NT_ACC, NT_SCR}, S1, 4, 1, NULL, alu}
+
+#define BYTES16(op) \
+	{NT_ACC, op, {NT_ACC, NT_RV}, S2, 24, 6, NULL, bytes16}, \
+	{NT_ACC, op, {NT_ACC, NT_SCR}, S2, 24, 6, NULL, bytes16}, \
+	{NT_ACC, op, {NT_ACC, NT_IMM}, S2, 30, 8, NULL, bytes16}, \
+	{NT_ACC, op, {NT_ACC, NT_FRAME}, S2, 54, 10, NULL, bytes16}, \
+	{NT_ACC, op, {NT_ACC, NT_IDX}, S2, 54, 10, NULL, bytes16}
+
+#define ALU32(op) \
+	{NT_L32, op, {NT_FRAME, NT_FRAME}, S4, 152, 24, NULL, NULL}, \
+	{NT_L32, op, {NT_FRAME, NT_IMM}, S4, 104, 20, NULL, NULL}, \
+	{NT_L32, op, {NT_IMM, NT_FRAME}, S4, 104, 20, NULL, NULL}, \
+	{NT_L32, op, {NT_ABS, NT_ABS}, S4, 196, 32, NULL, NULL}, \
+	{NT_L32, op, {NT_ABS, NT_FRAME}, S4, 128, 24, NULL, NULL}, \
+	{NT_L32, op, {NT_FRAME, NT_ABS}, S4, 172, 28, NULL, NULL}, \
+	{NT_L32, op, {NT_ABS, NT_IMM}, S4, 80, 20, NULL, NULL}, \
+	{NT_L32, op, {NT_IMM, NT_ABS}, S4, 148, 24, NULL, NULL}, \
+	{NT_R32, op, {NT_ACC, NT_FRAME}, S4, 92, 16, NULL, NULL}, \
+	{NT_R32, op, {NT_ACC, NT_IMM}, S4, 44, 12, NULL, NULL}, \
+	{NT_R32, op, {NT_ACC, NT_ABS}, S4, 136, 24, NULL, NULL}
+
+/* the conditions after OGT and OLE were turned around by label() */
+#define CMP(op) \
+	{NT_CC, op, {NT_ACC, NT_IMM}, S1, 7, 2, NULL, cmp8}, \
+	{NT_CC, op, {NT_ACC, NT_RV}, S1, 4, 1, NULL, cmp8}, \
+	{NT_CC, op, {NT_ACC, NT_FRAME}, S1, 19, 3, NULL, cmp8}, \
+	{NT_CC, op, {NT_ACC, NT_IND}, S1, 7, 1, NULL, cmp8}, \
+	{NT_CC, op, {NT_ACC, NT_IDX}, S1, 19, 3, NULL, cmp8}, \
+	{NT_CC, op, {NT_ACC, NT_SCR}, S1, 4, 1, NULL, cmp8}, \
+	{NT_CC, op, {NT_IMM, NT_SCR}, S1, 11, 3, NULL, bytecmp}, \
+	{NT_CC, op, {NT_ACC, NT_IMM}, S1, 4, 1, nil, test}, \
+	{NT_CC, op, {NT_ACC, NT_RV}, S2, 19, 3, NULL, cmp16}, \
+	{NT_CC, op, {NT_ACC, NT_SCR}, S2, 19, 3, NULL, cmp16}, \
+	{NT_CC, op, {NT_ACC, NT_IMM}, S2, 30, 8, NULL, bytecmp}, \
+	{NT_CC, op, {NT_ACC, NT_FRAME}, S2, 54, 10, NULL, bytecmp}, \
+	{NT_CC, op, {NT_IMM, NT_ACC}, S2, 22, 6, NULL, bytecmp}, \
+	{NT_CC, op, {NT_ACC, NT_IMM}, S2, 8, 2, nil, test}, \
+	{NT_CC, op, {NT_FRAME, NT_FRAME}, S4, 152, 24, NULL, bytecmp}, \
+	{NT_CC, op, {NT_FRAME, NT_IMM}, S4, 104, 20, NULL, bytecmp}, \
+	{NT_CC, op, {NT_IMM, NT_FRAME}, S4, 104, 20, NULL, bytecmp}, \
+	{NT_CC, op, {NT_ABS, NT_ABS}, S4, 196, 32, NULL, bytecmp}, \
+	{NT_CC, op, {NT_ABS, NT_FRAME}, S4, 128, 24, NULL, bytecmp}, \
+	{NT_CC, op, {NT_FRAME, NT_ABS}, S4, 172, 28, NULL, bytecmp}, \
+	{NT_CC, op, {NT_ABS, NT_IMM}, S4, 80, 20, NULL, bytecmp}, \
+	{NT_CC, op, {NT_ACC, NT_IMM}, S4, 80, 16, NULL, bytecmp}, \
+	{NT_CC, op, {NT_ACC, NT_FRAME}, S4, 104, 16, NULL, bytecmp}, \
+	{NT_CC, op, {NT_IMM, NT_ACC}, S4, 44, 12, NULL, bytecmp}, \
+	{NT_CC, op, {NT_FRAME, NT_IMM}, S4, 76, 12, nil, test}, \
+	{NT_CC, op, {NT_ABS, NT_IMM}, S4, 88, 16, nil, test}, \
+	{NT_CC, op, {NT_ACC, NT_IMM}, S4, 16, 4, nil, test}
+
+#define STEP(op) \
+	{NT_STEP, op, {NT_RV, NT_IMM}, S12, 0, 0, one, NULL}, \
+	{NT_STEP, op, {NT_FRAME, NT_IMM}, S1, 0, 0, one, NULL}, \
+	{NT_STEP, op, {NT_ABS, NT_IMM}, S1, 0, 0, one, NULL}
+
+#define ASSIGN(l, r, sizes, t, b) \
+	{NT_STMT, OASSIG, {l, r}, sizes, t, b, NULL, store}
+
+#define ASSIGN32(l, r, t, b) \
+	{NT_STMT, OASSIG, {l, r}, S4, t, b, NULL, store32}
+
+static struct rule rules[] = {
+	/* leaves */
+	{NT_IMM, CONST, {NONT, NONT}, SALL, 0, 0, NULL, NULL},
+	{NT_RV, REG, {NONT, NONT}, S12, 0, 0, NULL, NULL},
+	{NT_FRAME, AUTO, {NONT, NONT}, SALL|SX|S0, 0, 0, NULL, NULL},
+	{NT_FRAME, PAR, {NONT, NONT}, SALL|SX|S0, 0, 0, NULL, NULL},
+	{NT_ABS, MEM, {NONT, NONT}, SALL|SX|S0, 0, 0, NULL, NULL},
+
+	/* casts, the low bytes are in the same place */
+	{NT_IMM, OCAST, {NT_IMM, NONT}, SALL, 0, 0, NULL, pass},
+	{NT_RV, OCAST, {NT_RV, NONT}, S12, 0, 0, narrow, pass},
+	{NT_FRAME, OCAST, {NT_FRAME, NONT}, SALL, 0, 0, narrow, pass},
+	{NT_ABS, OCAST, {NT_ABS, NONT}, SALL, 0, 0, narrow, pass},
+	{NT_ACC, OCAST, {NT_ACC, NONT}, S12, 0, 0, samesize, pass},
+	{NT_ACC, OCAST, {NT_ACC, NONT}, S2, 0, 0, shorter, pass},
+	{NT_ACC, OCAST, {NT_ACC, NONT}, S1, 4, 1, shorter, low},
+	{NT_ACC, OCAST, {NT_ACC, NONT}, S2, 11, 3, zext, ext},
+	{NT_ACC, OCAST, {NT_ACC, NONT}, S2, 16, 4, sext, ext},
+	{NT_ACC, OCAST, {NT_L32, NONT}, S12, 40, 8, NULL, low32},
+	{NT_ACC, OCAST, {NT_R32, NONT}, S12, 24, 4, NULL, low32},
+	{NT_X32, OCAST, {NT_ACC, NONT}, S4, 0, 0, wider, NULL},
+	{NT_X32, OCAST, {NT_FRAME, NONT}, S4, 0, 0, wider, NULL},
+	{NT_X32, OCAST, {NT_ABS, NONT}, S4, 0, 0, wider, NULL},
+
+	/* loads in the accumulator */
+	{NT_ACC, 0, {NT_IMM, NONT}, S1, 7, 2, NULL, load},
+	{NT_ACC, 0, {NT_IMM, NONT}, S1, 4, 1, zero, clra},
+	{NT_ACC, 0, {NT_IMM, NONT}, S2, 10, 3, NULL, load},
+	{NT_ACC, 0, {NT_RV, NONT}, S1, 4, 1, NULL, load},
+	{NT_ACC, 0, {NT_RV, NONT}, S2, 8, 2, NULL, load},
+	{NT_ACC, 0, {NT_FRAME, NONT}, S1, 19, 3, NULL, load},
+	{NT_ACC, 0, {NT_FRAME, NONT}, S2, 38, 6, NULL, load},
+	{NT_ACC, 0, {NT_ABS, NONT}, S1, 13, 3, NULL, load},
+	{NT_ACC, 0, {NT_ABS, NONT}, S2, 16, 3, NULL, load},
+	{NT_ACC, 0, {NT_IND, NONT}, S1, 7, 1, NULL, load},
+	{NT_ACC, 0, {NT_IDX, NONT}, S1, 19, 3, NULL, load},
+	{NT_ACC, 0, {NT_IDX, NONT}, S2, 38, 6, NULL, load},
+	{NT_ACC, 0, {NT_RV, NONT}, S12, 0, 0, cached, reuse},
+	{NT_ACC, 0, {NT_FRAME, NONT}, S12, 0, 0, cached, reuse},
+	{NT_ACC, 0, {NT_ABS, NONT}, S12, 0, 0, cached, reuse},
+	{NT_ACC, 0, {NT_GADDR, NONT}, S2, 10, 3, NULL, ldaddr},
+	{NT_ACC, 0, {NT_FADDR, NONT}, S2, 65, 11, NULL, ldaddr},
+
+	/* addresses */
+	{NT_FADDR, OADDR, {NT_FRAME, NONT}, S2, 0, 0, NULL, addrof},
+	{NT_GADDR, OADDR, {NT_ABS, NONT}, S2, 0, 0, NULL, addrof},
+	{NT_FADDR, OADD, {NT_FADDR, NT_IMM}, S2, 0, 0, NULL, offset},
+	{NT_GADDR, OADD, {NT_GADDR, NT_IMM}, S2, 0, 0, NULL, offset},
+	{NT_FRAME, OPTR, {NT_FADDR, NONT}, SALL|SX, 0, 0, NULL, deref},
+	{NT_ABS, OPTR, {NT_GADDR, NONT}, SALL|SX, 0, 0, NULL, deref},
+	{NT_IND, 0, {NT_ABS, NONT}, S1, 10, 3, NULL, ind},
+	{NT_IND, OPTR, {NT_IMM, NONT}, S12, 10, 3, NULL, indptr},
+	{NT_IND, OPTR, {NT_RV, NONT}, S12, 8, 2, NULL, indptr},
+	{NT_IND, OPTR, {NT_ABS, NONT}, S12, 16, 3, NULL, indptr},
+	{NT_IND, OPTR, {NT_FRAME, NONT}, S12, 38, 6, NULL, indptr},
+	{NT_HLP, OPTR, {NT_ACC, NONT}, SALL, 0, 0, NULL, hlptr},
+	{NT_SADDR, OPTR, {NT_ACC, NONT}, S12, 25, 3, NULL, pushaddr},
+	{NT_IY, 0, {NT_RV, NONT}, S2, 25, 3, NULL, iy},
+	{NT_IY, 0, {NT_IMM, NONT}, S2, 14, 4, NULL, iy},
+	{NT_IY, 0, {NT_ABS, NONT}, S2, 20, 4, NULL, iy},
+	{NT_IY, 0, {NT_GADDR, NONT}, S2, 14, 4, NULL, iy},
+	{NT_IYD, 0, {NT_IY, NONT}, S2, 0, 0, NULL, iyd},
+	{NT_IYD, OADD, {NT_IY, NT_IMM}, S2, 0, 0, disp, iyd},
+	{NT_IDX, OPTR, {NT_IYD, NONT}, SALL, 0, 0, NULL, idx},
+	{NT_ACC, OPTR, {NT_ACC, NONT}, S1, 7, 1, NULL, accptr},
+	{NT_ACC, OPTR, {NT_ACC, NONT}, S2, 24, 4, NULL, accptr},
+
+	/* operations of 8 bits */
+	ALU8(OADD),
+	ALU8(OSUB),
+	ALU8(OBAND),
+	ALU8(OBOR),
+	ALU8(OBXOR),
+	{NT_ACC, OADD, {NT_ACC, NT_IMM}, S1, 4, 1, one, incacc},
+	{NT_ACC, OSUB, {NT_ACC, NT_IMM}, S1, 4, 1, one, incacc},
+	{NT_ACC, OCPL, {NT_ACC, NONT}, S1, 4, 1, NULL, cpl},
+	{NT_ACC, ONEG, {NT_ACC, NONT}, S1, 8, 2, NULL, cpl},
+	{NT_ACC, OSHL, {NT_ACC, NT_IMM}, S1, 8, 2, NULL, shift},
+	{NT_ACC, OSHR, {NT_ACC, NT_IMM}, S1, 16, 4, NULL, shift},
+	{NT_SCR, 0, {NT_ACC, NONT}, S1, 4, 1, NULL, save},
+
+	/* operations of 16 bits */
+	{NT_ACC, OADD, {NT_ACC, NT_RV}, S2, 11, 1, NULL, add16},
+	{NT_ACC, OADD, {NT_ACC, NT_SCR}, S2, 11, 1, NULL, add16},
+	{NT_ACC, OADD, {NT_ACC, NT_GADDR}, S2, 42, 6, NULL, addaddr},
+	{NT_ACC, OADD, {NT_ACC, NT_IMM}, S2, 6, 1, one, incacc},
+	{NT_ACC, OSUB, {NT_ACC, NT_IMM}, S2, 6, 1, one, incacc},
+	{NT_ACC, OSUB, {NT_ACC, NT_RV}, S2, 19, 3, NULL, sub16},
+	{NT_ACC, OSUB, {NT_ACC, NT_SCR}, S2, 19, 3, NULL, sub16},
+	BYTES16(OADD),
+	BYTES16(OSUB),
+	BYTES16(OBAND),
+	BYTES16(OBOR),
+	BYTES16(OBXOR),
+	{NT_ACC, OCPL, {NT_ACC, NONT}, S2, 24, 6, NULL, cpl16},
+	{NT_ACC, ONEG, {NT_ACC, NONT}, S2, 24, 6, NULL, neg16},
+	{NT_ACC, OSHL, {NT_ACC, NT_IMM}, S2, 11, 1, NULL, shift},
+	{NT_ACC, OSHR, {NT_ACC, NT_IMM}, S2, 16, 4, NULL, shift},
+	{NT_SCR, 0, {NT_ACC, NONT}, S2, 8, 2, spare, save},
+	{NT_SCR, 0, {NT_ACC, NONT}, S2, 71, 8, NULL, save},
+	{NT_SCR, 0, {NT_IMM, NONT}, S2, 10, 3, spare, scrload},
+	{NT_SCR, 0, {NT_FRAME, NONT}, S2, 38, 6, spare, scrload},
+	{NT_SCR, 0, {NT_ABS, NONT}, S2, 20, 4, spare, scrload},
+
+	/* operations of 32 bits */
+	{NT_L32, 0, {NT_FRAME, NONT}, S4, 76, 12, NULL, NULL},
+	{NT_L32, 0, {NT_ABS, NONT}, S4, 52, 12, NULL, NULL},
+	{NT_L32, 0, {NT_IMM, NONT}, S4, 28, 8, NULL, NULL},
+	ALU32(OADD),
+	ALU32(OSUB),
+	ALU32(OBAND),
+	ALU32(OBOR),
+	ALU32(OBXOR),
+	{NT_L32, OCPL, {NT_FRAME, NONT}, S4, 92, 16, NULL, NULL},
+	{NT_L32, ONEG, {NT_FRAME, NONT}, S4, 101, 19, NULL, NULL},
+	{NT_R32, OCPL, {NT_ACC, NONT}, S4, 48, 8, NULL, NULL},
+	{NT_ACC, 0, {NT_FRAME, NONT}, S4, 76, 12, dehl, load32},
+	{NT_ACC, 0, {NT_ABS, NONT}, S4, 36, 7, dehl, load32},
+	{NT_ACC, 0, {NT_IMM, NONT}, S4, 20, 6, dehl, load32},
+	{NT_ACC, 0, {NT_L32, NONT}, S4, 16, 4, dehl, acc32},
+	{NT_ACC, 0, {NT_R32, NONT}, S4, 16, 4, dehl, acc32},
+	{NT_ACC, 0, {NT_X32, NONT}, S4, 40, 8, dehl, acc32},
+
+	/* conditions */
+	CMP(OEQ),
+	CMP(ONE),
+	CMP(OLT),
+	CMP(OGE),
+	{NT_CC, 0, {NT_ACC, NONT}, S1, 4, 1, NULL, nz},
+	{NT_CC, 0, {NT_ACC, NONT}, S2, 8, 2, NULL, nz},
+	{NT_CC, 0, {NT_ACC, NONT}, S4, 16, 4, NULL, nz},
+	{NT_ACC, OASK, {NONT, NONT}, S12, 30, 8, NULL, ask},
+
+	/* calls, see pushargs() */
+	{NT_ACC, OCALL, {NONT, NONT}, SALL, 17, 3, dehl, call},
+	{NT_STMT, OCALL, {NONT, NONT}, SALL|S0, 17, 3, dehl, call},
+
+	/* assignments of 8 bits */
+	ASSIGN(NT_RV, NT_ACC, S1, 4, 1),
+	ASSIGN(NT_RV, NT_IMM, S1, 7, 2),
+	ASSIGN(NT_RV, NT_RV, S1, 4, 1),
+	ASSIGN(NT_RV, NT_FRAME, S1, 19, 3),
+	ASSIGN(NT_RV, NT_IND, S1, 7, 1),
+	ASSIGN(NT_RV, NT_IDX, S1, 19, 3),
+	ASSIGN(NT_FRAME, NT_ACC, S1, 19, 3),
+	ASSIGN(NT_FRAME, NT_RV, S1, 19, 3),
+	ASSIGN(NT_FRAME, NT_IMM, S1, 19, 4),
+	ASSIGN(NT_ABS, NT_ACC, S1, 13, 3),
+	ASSIGN(NT_IND, NT_ACC, S1, 7, 1),
+	ASSIGN(NT_IND, NT_RV, S1, 7, 1),
+	ASSIGN(NT_IND, NT_IMM, S1, 10, 2),
+	ASSIGN(NT_HLP, NT_RV, S1, 7, 1),
+	ASSIGN(NT_HLP, NT_IMM, S1, 10, 2),
+	ASSIGN(NT_IDX, NT_ACC, S1, 19, 3),
+	ASSIGN(NT_IDX, NT_RV, S1, 19, 3),
+	ASSIGN(NT_IDX, NT_IMM, S1, 19, 4),
+	{NT_STMT, OASSIG, {NT_SADDR, NT_ACC}, S1, 33, 5, NULL, popaddr},
+	STEP(OADD),
+	STEP(OSUB),
+	{NT_STMT, OASSIG, {NT_RV, NT_STEP}, S1, 4, 1, same, step},
+	{NT_STMT, OASSIG, {NT_RV, NT_STEP}, S2, 6, 1, same, step},
+	{NT_STMT, OASSIG, {NT_FRAME, NT_STEP}, S1, 23, 3, same, step},
+	{NT_STMT, OASSIG, {NT_ABS, NT_STEP}, S1, 21, 4, same, step},
+
+	/* assignments of 16 bits */
+	ASSIGN(NT_RV, NT_ACC, S2, 8, 2),
+	ASSIGN(NT_RV, NT_IMM, S2, 10, 3),
+	ASSIGN(NT_RV, NT_RV, S2, 8, 2),
+	ASSIGN(NT_RV, NT_FRAME, S2, 38, 6),
+	ASSIGN(NT_RV, NT_ABS, S2, 20, 4),
+	ASSIGN(NT_FRAME, NT_ACC, S2, 38, 6),
+	ASSIGN(NT_FRAME, NT_RV, S2, 38, 6),
+	ASSIGN(NT_FRAME, NT_IMM, S2, 38, 8),
+	ASSIGN(NT_ABS, NT_ACC, S2, 16, 3),
+	ASSIGN(NT_ABS, NT_RV, S2, 20, 4),
+	ASSIGN(NT_IND, NT_RV, S2, 20, 3),
+	ASSIGN(NT_IND, NT_IMM, S2, 26, 5),
+	ASSIGN(NT_IND, NT_SCR, S2, 20, 3),
+	ASSIGN(NT_HLP, NT_RV, S2, 20, 3),
+	ASSIGN(NT_HLP, NT_IMM, S2, 26, 5),
+	ASSIGN(NT_HLP, NT_SCR, S2, 20, 3),
+	ASSIGN(NT_IDX, NT_ACC, S2, 38, 6),
+	ASSIGN(NT_IDX, NT_RV, S2, 38, 6),
+	ASSIGN(NT_IDX, NT_IMM, S2, 38, 8),
+	ASSIGN(NT_IDX, NT_SCR, S2, 38, 6),
+	{NT_STMT, OASSIG, {NT_SADDR, NT_ACC}, S2, 52, 8, NULL, popaddr},
+
+	/* assignments used as values */
+	{NT_ACC, OASSIG, {NT_RV, NT_ACC}, S1, 4, 1, NULL, store},
+	{NT_ACC, OASSIG, {NT_FRAME, NT_ACC}, S1, 19, 3, NULL, store},
+	{NT_ACC, OASSIG, {NT_ABS, NT_ACC}, S1, 13, 3, NULL, store},
+	{NT_ACC, OASSIG, {NT_RV, NT_ACC}, S2, 8, 2, NULL, store},
+	{NT_ACC, OASSIG, {NT_FRAME, NT_ACC}, S2, 38, 6, NULL, store},
+	{NT_ACC, OASSIG, {NT_ABS, NT_ACC}, S2, 16, 3, NULL, store},
+	{NT_ACC, OINC, {NT_RV, NT_IMM}, S12, 8, 2, small, postinc},
+	{NT_ACC, OINC, {NT_FRAME, NT_IMM}, S12, 76, 12, small, postinc},
+	{NT_ACC, OINC, {NT_ABS, NT_IMM}, S12, 44, 8, small, postinc},
+
+	/* cc1 assigns its temporaries in a comma before the expression */
+	{NT_STMT, OCOMMA, {NT_STMT, NT_STMT}, SALL, 0, 0, NULL, NULL},
+	{NT_ACC, OCOMMA, {NT_STMT, NT_ACC}, S12, 0, 0, NULL, comma},
+
+	/* values that are not used */
+	{NT_STMT, 0, {NT_IMM, NONT}, SALL, 0, 0, NULL, NULL},
+	{NT_STMT, 0, {NT_RV, NONT}, SALL, 0, 0, NULL, NULL},
+	{NT_STMT, 0, {NT_FRAME, NONT}, SALL, 0, 0, NULL, NULL},
+	{NT_STMT, 0, {NT_ABS, NONT}, SALL, 0, 0, NULL, NULL},
+	{NT_STMT, 0, {NT_ACC, NONT}, SALL, 0, 0, NULL, NULL},
+
+	/* assignments of 32 bits */
+	ASSIGN32(NT_FRAME, NT_L32, 76, 12),
+	ASSIGN32(NT_FRAME, NT_R32, 76, 12),
+	ASSIGN32(NT_FRAME, NT_X32, 76, 12),
+	ASSIGN32(NT_FRAME, NT_IMM, 76, 16),
+	ASSIGN32(NT_FRAME, NT_ACC, 76, 12),
+	ASSIGN32(NT_ABS, NT_L32, 52, 12),
+	ASSIGN32(NT_ABS, NT_R32, 52, 12),
+	ASSIGN32(NT_ABS, NT_X32, 52, 12),
+	ASSIGN32(NT_ABS, NT_IMM, 52, 12),
+	ASSIGN32(NT_ABS, NT_ACC, 40, 7),
+	ASSIGN32(NT_HLP, NT_L32, 52, 8),
+	ASSIGN32(NT_HLP, NT_IMM, 52, 11),
+	ASSIGN32(NT_IDX, NT_IMM, 76, 16),
+};
+
+#define NR_RULES (sizeof(rules) / sizeof(rules[0]))
+
+static bool
+less(struct cost c1, struct cost c2)
+{
+	return c1.t < c2.t || c1.t == c2.t && c1.b < c2.b;
+}
+
+static unsigned
+sizebit(Node *np)
+{
+	switch (np->type.size) {
+	case 0:
+		return S0;
+	case 1:
+		return S1;
+	case 2:
+		return S2;
+	case 4:
+		return S4;
+	default:
+		return SX;
+	}
+}
+
+static bool
+commutative(int op)
+{
+	switch (op) {
+	case OADD:
+	case OBAND:
+	case OBOR:
+	case OBXOR:
+	case OEQ:
+	case ONE:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+static void
+conmute(Node *np)
+{
+	Node *p = np->left;
+
+	np->left = np->right;
+	np->right = p;
+}
+
+static Node *
+newtmp(Sel *sp)
+{
+	Node *np;
+
+	if (sp->ntmps == sp->maxtmps) {
+		sp->maxtmps = (sp->maxtmps) ? 2*sp->maxtmps : 4;
+		sp->tmps = xrealloc(sp->tmps, sp->maxtmps * sizeof(Node *));
+	}
+	np = sp->tmps[sp->ntmps++] = xcalloc(1, sizeof(Node));
+	return np;
+}
+
+static Node *
+copy(Sel *sp, Node *np)
+{
+	Node *new;
+
+	if (!np)
+		return NULL;
+	new = newtmp(sp);
+	*new = *np;
+	new->left = copy(sp, np->left);
+	new->right = copy(sp, np->right);
+	return new;
+}
+
+/* x op= y is x = x op y, with a copy of x */
+static void
+expand(Sel *sp, Node *np)
+{
+	Node *op = newtmp(sp), *x = copy(sp, np->left);
+
+	op->op = np->subop;
+	op->type = np->type;
+	op->left = x;
+	op->right = np->right;
+	np->right = op;
+	np->subop = 0;
+}
+
+/* the operations that the Z80 does not have */
+static bool
+islib(Node *np)
+{
+	switch (np->op) {
+	case OMUL:
+	case ODIV:
+	case OMOD:
+		return 1;
+	case OSHL:
+	case OSHR:
+		return np->type.size > 2 || leaf(np->right)->op != CONST;
+	default:
+		return 0;
+	}
+}
+
+/* x op y is a call to the runtime library, see pushargs() */
+static void
+libcall(Sel *sp, Node *np)
+{
+	Node *fp = newtmp(sp), *p1 = newtmp(sp), *p2 = newtmp(sp), *y;
+	bool sign = np->type.flags & SIGNF;
+	int i;
+
+	switch (np->op) {
+	case OMUL:
+		i = 0;
+		break;
+	case ODIV:
+		i = (sign) ? 1 : 2;
+		break;
+	case OMOD:
+		i = (sign) ? 3 : 4;
+		break;
+	case OSHL:
+		i = 5;
+		break;
+	default:
+		i = (sign) ? 6 : 7;
+		break;
+	}
+	switch (np->type.size) {
+	case 1:
+		i = 3*i;
+		break;
+	case 2:
+		i = 3*i + 1;
+		break;
+	case 4:
+		i = 3*i + 2;
+		break;
+	default:
+		fail(sp);
+	}
+
+	/* the count of a shift has the size of the value */
+	y = np->right;
+	if (y->op != CONST && y->type.size != np->type.size) {
+		p2->op = OCAST;
+		p2->type = np->type;
+		p2->left = y;
+		y = p2;
+		p2 = newtmp(sp);
+	}
+
+	fp->op = MEM;
+	fp->sym = &rtlib[i];
+	p1->op = p2->op = OPAR;
+	p1->type = p2->type = np->type;
+	p1->left = np->left;
+	p1->right = p2;
+	p2->left = y;
+	np->op = OCALL;
+	np->left = fp;
+	np->right = p1;
+}
+
+/* c used as a value is c ? 1 : 0 */
+static Node *
+boolval(Sel *sp, Node *np)
+{
+	Node *ask = newtmp(sp), *colon = newtmp(sp);
+	Node *t = newtmp(sp), *f = newtmp(sp);
+
+	t->op = f->op = CONST;
+	t->imm = 1;
+	t->type = f->type = colon->type = ask->type = np->type;
+	colon->op = OCOLON;
+	colon->left = t;
+	colon->right = f;
+	ask->op = OASK;
+	ask->left = np;
+	ask->right = colon;
+	return ask;
+}
+
+/*
+ * x > y is y < x and x <= y is y >= x, and the type of a
+ * comparison is the type of its operands
+ */
+static void
+cmpnode(Node *np)
+{
+	switch (np->op) {
+	case OGT:
+		conmute(np);
+		np->op = OLT;
+		break;
+	case OLE:
+		conmute(np);
+		np->op = OGE;
+		break;
+	case OLT:
+	case OGE:
+	case OEQ:
+	case ONE:
+		break;
+	default:
+		return;
+	}
+	np->type = (np->left->op == CONST) ? np->right->type : np->left->type;
+}
+
+/* the constants take the size of the operation */
+static void
+fixconst(Node *parent, Node *np)
+{
+	if (np->op != CONST || parent->op == OCAST || parent->op == OPTR)
+		return;
+	np->type = parent->type;
+}
+
+static unsigned
+newstate(Sel *sp)
+{
+	struct state *st;
+	int i;
+
+	if (sp->nstates == sp->maxstates) {
+		sp->maxstates = (sp->maxstates) ? 2*sp->maxstates : 16;
+		sp->states = xrealloc(sp->states,
+		                      sp->maxstates * sizeof(*sp->states));
+	}
+	st = &sp->states[sp->nstates];
+	for (i = 0; i < NR_NT; ++i) {
+		st->cost[i].t = st->cost[i].b = INF;
+		st->swap[i] = 0;
+	}
+	st->pushed = 0;
+	return sp->nstates++;
+}
+
+static void
+match(Sel *sp, Node *np, struct rule *rp, bool swap)
+{
+	struct state *st = &sp->states[np->state];
+	struct cost c, kc;
+	Node *kid;
+	int i, nt = rp->nt;
+
+	if (swap)
+		conmute(np);
+	c.t = rp->t;
+	c.b = rp->b;
+	for (i = 0; i < 2; ++i) {
+		if (rp->kids[i] == NONT)
+			continue;
+		if ((kid = (i == 0) ? np->left : np->right) == NULL)
+			goto out;
+		kc = sp->states[kid->state].cost[rp->kids[i]];
+		if (kc.t == INF)
+			goto out;
+		c.t += kc.t;
+		c.b += kc.b;
+	}
+	if (rp->cond && !(*rp->cond)(sp, np))
+		goto out;
+	if (less(c, st->cost[nt])) {
+		st->cost[nt] = c;
+		st->rule[nt] = rp - rules;
+		st->swap[nt] = swap;
+	}
+out:
+	if (swap)
+		conmute(np);
+}
+
+static void
+closure(Sel *sp, Node *np)
+{
+	struct state *st = &sp->states[np->state];
+	struct rule *rp;
+	struct cost c;
+	unsigned size = sizebit(np);
+	bool changed;
+
+	do {
+		changed = 0;
+		for (rp = rules; rp < &rules[NR_RULES]; ++rp) {
+			if (rp->op != 0 || !(rp->sizes & size))
+				continue;
+			c = st->cost[rp->kids[0]];
+			if (c.t == INF)
+				continue;
+			if (rp->cond && !(*rp->cond)(sp, np))
+				continue;
+			c.t += rp->t;
+			c.b += rp->b;
+			if (less(c, st->cost[rp->nt])) {
+				st->cost[rp->nt] = c;
+				st->rule[rp->nt] = rp - rules;
+				st->swap[rp->nt] = 0;
+				changed = 1;
+			}
+		}
+	} while (changed);
+}
+
+/* the conditions are values, except where branch() takes them */
+static bool
+takescond(Node *np, Node *kid)
+{
+	return np->op == OAND || np->op == OOR ||
+	       np->op == OASK && kid == np->left;
+}
+
+static void
+label(Sel *sp, Node *np)
+{
+	Node *lp, *rp;
+	struct rule *r;
+	unsigned size;
+
+	if (np->op == OASSIG && np->subop)
+		expand(sp, np);
+	if (islib(np))
+		libcall(sp, np);
+	cmpnode(np);
+	if (np->type.size == 4)
+		sp->wide = 1;
+
+	if ((lp = np->left) != NULL) {
+		if (iscond(lp) && !takescond(np, lp))
+			lp = np->left = boolval(sp, lp);
+		fixconst(np, lp);
+		label(sp, lp);
+	}
+	if ((rp = np->right) != NULL) {
+		if (iscond(rp) && !takescond(np, rp))
+			rp = np->right = boolval(sp, rp);
+		fixconst(np, rp);
+		label(sp, rp);
+	}
+
+	np->state = newstate(sp);
+	size = sizebit(np);
+	for (r = rules; r < &rules[NR_RULES]; ++r) {
+		if (r->op != np->op || !(r->sizes & size))
+			continue;
+		match(sp, np, r, 0);
+		if (lp && rp && commutative(np->op))
+			match(sp, np, r, 1);
+	}
+	closure(sp, np);
+}
+
+/*
+ * The statements and the saved values are computed first, then
+ * the value of the accumulator, and at the end the addresses,
+ * which do not use A. Only the left side of a comma is a
+ * statement, so it is always evaluated before the right side.
+ * The addresses saved in the stack are computed with the saved
+ * values, because they use HL.
+ */
+static int
+rank(int nt)
+{
+	switch (nt) {
+	case NT_STMT:
+	case NT_SCR:
+	case NT_SADDR:
+		return 0;
+	case NT_ACC:
+		return 1;
+	default:
+		return 2;
+	}
+}
+
+static bool
+reads(Node *np, uint8_t r)
+{
+	if (!np)
+		return 0;
+	if (np->op == REG &&
+	    (np->reg == r || np->reg == lower[r] || np->reg == upper[r])) {
+		return 1;
+	}
+	return reads(np->left, r) || reads(np->right, r);
+}
+
+/*
+ * The bytes saved in the stack go to H, before HL is used. The
+ * words go through IY to a pair that the other operand does not
+ * read, and the value of the pair is kept in the stack until the
+ * operation is done (see reduce()).
+ */
+static void
+fetch(Sel *sp, struct rule *rp, Node **kids)
+{
+	Addr none = {.kind = NONE};
+	Node *np;
+	uint8_t r;
+	int i;
+
+	for (i = 0; i < 2; ++i) {
+		np = kids[i];
+		if (rp->kids[i] != NT_SCR || !sp->states[np->state].pushed)
+			continue;
+		if (np->type.size == 1) {
+			op2(sp, POP, areg(HL), none);
+			continue;
+		}
+		r = (reads(kids[!i], DE)) ? BC : DE;
+		op2(sp, POP, areg(IY), none);
+		op2(sp, PUSH, none, areg(r));
+		op2(sp, PUSH, none, areg(IY));
+		op2(sp, POP, areg(r), none);
+		sp->busy[r] = 1;
+		np->reg = r;
+	}
+}
+
+static void
+reduce(Sel *sp, Node *np, int nt)
+{
+	struct state *st = &sp->states[np->state];
+	struct rule *rp;
+	Node *kids[2];
+	int i, pass;
+
+	if (st->cost[nt].t == INF)
+		fail(sp);
+	rp = &rules[st->rule[nt]];
+	if (st->swap[nt])
+		conmute(np);
+
+	if (rp->op == 0) {
+		reduce(sp, np, rp->kids[0]);
+	} else {
+		kids[0] = np->left;
+		kids[1] = np->right;
+		for (pass = 0; pass < 3; ++pass) {
+			if (pass == 2)
+				fetch(sp, rp, kids);
+			for (i = 0; i < 2; ++i) {
+				if (rp->kids[i] != NONT && rank(rp->kids[i]) == pass)
+					reduce(sp, kids[i], rp->kids[i]);
+			}
+		}
+	}
+
+	if (rp->emit)
+		(*rp->emit)(sp, np);
+
+	if (rp->op != 0) {
+		for (i = 0; i < 2; ++i) {
+			if (rp->kids[i] != NT_SCR)
+				continue;
+			sp->busy[kids[i]->reg] = 0;
+			if (sp->states[kids[i]->state].pushed &&
+			    kids[i]->type.size == 2) {
+				op2(sp, POP, areg(kids[i]->reg),
+				    (Addr) {.kind = NONE});
+			}
+		}
+	}
+}
+
+static void
+begin(Sel *sp, Func *fn)
+{
+	memset(sp, 0, sizeof(*sp));
+	sp->fn = fn;
+}
+
+static void
+end(Sel *sp)
+{
+	Func *fn = sp->fn;
+	unsigned i;
+
+	for (i = 0; i < sp->ntmps; ++i) {
+		if (fn->reguse[A] == sp->tmps[i])
+			fn->reguse[A] = NULL;
+		if (fn->reguse[HL] == sp->tmps[i])
+			fn->reguse[HL] = NULL;
+		xfree(sp->tmps[i]);
+	}
+	xfree(sp->tmps);
+	xfree(sp->states);
+}
+
+static void
+isel(Func *fn, Node *np, bool value)
+{
+	Sel sel, *sp = &sel;
+	int goal;
+
+	begin(sp, fn);
+	/* the value of x++ is not used, so it is x += 1 */
+	if (!value && np->op == OINC)
+		np->op = OASSIG;
+	if (iscond(np))
+		np = boolval(sp, np);
+	label(sp, np);
+	goal = NT_ACC;
+	if (!value && sp->states[np->state].cost[NT_STMT].t != INF)
+		goal = NT_STMT;
+	reduce(sp, np, goal);
+	end(sp);
+}
+
+/* code of an expression used as statement */
+void
+selstmt(Func *fn, Node *np)
+{
+	isel(fn, np, 0);
+}
+
+/* code of an expression, with the value in A, HL or DE:HL */
+void
+selvalue(Func *fn, Node *np)
+{
+	isel(fn, np, 1);
+}
+
+/* code of a conditional jump to the label */
+void
+selbranch(Func *fn, Node *np, Symbol *to)
+{
+	Sel sel, *sp = &sel;
+
+	begin(sp, fn);
+	label(sp, np);
+	branch(sp, np, to, 1);
+	end(sp);
+}
+
+/*
+ * An entry of the table of a switch, where the value arrives in A
+ * or HL. The value was already decreased by the previous entries,
+ * see oswitch() of cgen.c, and now it is decreased by the
+ * difference with this one.
+ */
+void
+selcase(Func *fn, Node *np)
+{
+	Sel sel, *sp = &sel;
+	TINT d = np->imm;
+	uint8_t rr;
+	Addr a;
+
+	begin(sp, fn);
+	switch (np->type.size) {
+	case 1:
+		if (d &= 0xFF)
+			op2(sp, SUB, areg(A), aimm(d));
+		else
+			op2(sp, OR, areg(A), areg(A));
+		break;
+	case 2:
+		d &= 0xFFFF;
+		if (d <= 3) {
+			for (; d > 0; --d)
+				op1(sp, DEC, HL);
+		} else if (d >= 0xFFFD) {
+			for (; d < 0x10000; ++d)
+				op1(sp, INC, HL);
+		} else {
+			rr = (isregvar(fn, DE)) ? BC : DE;
+			a = areg(rr);
+			if (isregvar(fn, rr))
+				inst(sp, PUSH, NULL, &a);
+			move(sp, a, aimm(-d & 0xFFFF));
+			op2(sp, ADD, areg(HL), a);
+			if (isregvar(fn, rr))
+				inst(sp, POP, &a, NULL);
+		}
+		move(sp, areg(A), areg(H));
+		op2(sp, OR, areg(A), areg(L));
+		break;
+	default:
+		fail(sp);
+	}
+	jp(sp, CCZ, np->sym);
+	end(sp);
+}
@@ -0,0 +1,271 @@
+
+#include <inttypes.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../inc/cc.h"
+#include "cc2.h"
+
+#define BITS (sizeof(unsigned long) * CHAR_BIT)
+
+/*
+ * Liveness of the local variables over the control flow graph.
+ * The variables whose address is taken are not tracked, because
+ * they can be used through pointers. The sets are bit vectors of
+ * setsiz words, and the variables are indexed by their position
+ * in fn->vars, which is sorted by id.
+ */
+static int
+cmpsym(const void *p1, const void *p2)
+{
+	unsigned id1 = (*(Symbol **) p1)->id, id2 = (*(Symbol **) p2)->id;
+
+	return (id1 > id2) - (id1 < id2);
+}
+
+int
+varidx(Func *fn, Symbol *sym)
+{
+	Symbol **p;
+
+	if (fn->nvars == 0)
+		return -1;
+	p = bsearch(&sym, fn->vars, fn->nvars, sizeof(Symbol *), cmpsym);
+	return (p) ? p - fn->vars : -1;
+}
+
+bool
+islive(unsigned long *set, int idx)
+{
+	return set[idx / BITS] & 1UL << idx % BITS;
+}
+
+struct vars {
+	Symbol **v;
+	unsigned n, max;
+	Symbol **addr;
+	unsigned naddr, maxaddr;
+};
+
+static void
+addsym(Symbol ***vp, unsigned *n, unsigned *max, Symbol *sym)
+{
+	if (*n == *max) {
+		*max = (*max) ? 2 * *max : 16;
+		*vp = xrealloc(*vp, *max * sizeof(Symbol *));
+	}
+	(*vp)[(*n)++] = sym;
+}
+
+static void
+collect(struct vars *vp, Node *np)
+{
+	if (!np)
+		return;
+	if (np->op == OADDR && np->left->op == AUTO)
+		addsym(&vp->addr, &vp->naddr, &vp->maxaddr, np->left->sym);
+	else if (np->op == AUTO && np->sym)
+		addsym(&vp->v, &vp->n, &vp->max, np->sym);
+	collect(vp, np->left);
+	collect(vp, np->right);
+}
+
+/* sort the symbols and remove the duplicated ones */
+static unsigned
+uniq(Symbol **v, unsigned n)
+{
+	unsigned i, j;
+
+	if (n == 0)
+		return 0;
+	qsort(v, n, sizeof(Symbol *), cmpsym);
+	for (i = j = 1; i < n; ++i) {
+		if (v[i] != v[j-1])
+			v[j++] = v[i];
+	}
+	return j;
+}
+
+static void
+findvars(Func *fn)
+{
+	struct vars vars;
+	Node **stmt;
+	unsigned i, j;
+	Symbol *key;
+
+	memset(&vars, 0, sizeof(vars));
+	for (stmt = fn->body; *stmt; ++stmt)
+		collect(&vars, *stmt);
+	vars.n = uniq(vars.v, vars.n);
+	vars.naddr = uniq(vars.addr, vars.naddr);
+
+	for (i = j = 0; i < vars.n; ++i) {
+		key = vars.v[i];
+		if (!bsearch(&key, vars.addr, vars.naddr, sizeof(Symbol *),
+		             cmpsym)) {
+			vars.v[j++] = key;
+		}
+	}
+	xfree(vars.addr);
+	xfree(fn->vars);
+	fn->vars = vars.v;
+	fn->nvars = j;
+	fn->setsiz = (j + BITS-1) / BITS;
+}
+
+static void
+gen(Func *fn, Node *np, unsigned long *set)
+{
+	int idx;
+
+	if (!np)
+		return;
+	if (np->op == AUTO && (idx = varidx(fn, np->sym)) >= 0)
+		set[idx / BITS] |= 1UL << idx % BITS;
+	gen(fn, np->left, set);
+	gen(fn, np->right, set);
+}
+
+/* variable written by a simple assignment at the top of a statement */
+static int
+target(Func *fn, Node *np)
+{
+	if (np->op != OASSIG || np->subop != 0 || np->left->op != AUTO)
+		return -1;
+	return varidx(fn, np->left->sym);
+}
+
+/* the set of live variables before the statement */
+static void
+transfer(Func *fn, Node *np, unsigned long *set)
+{
+	int idx;
+
+	if ((idx = target(fn, np)) >= 0) {
+		set[idx / BITS] &= ~(1UL << idx % BITS);
+		gen(fn, np->right, set);
+	} else {
+		gen(fn, np, set);
+	}
+}
+
+static bool
+pure(Node *np)
+{
+	if (!np)
+		return 1;
+	if (np->op == OASSIG || np->op == OINC)
+		return 0;
+	return pure(np->left) && pure(np->right);
+}
+
+static void
+blocklive(Func *fn, Block *bp, unsigned long *set)
+{
+	unsigned i;
+
+	memcpy(set, bp->out, fn->setsiz * sizeof(*set));
+	for (i = bp->end; i-- > bp->begin; )
+		transfer(fn, fn->body[i], set);
+}
+
+/*
+ * Backward dataflow over the reachable blocks, visited in
+ * postorder, so the successors are usually done before
+ */
+void
+liveness(Func *fn)
+{
+	Block *bp;
+	unsigned long *set, *in;
+	unsigned i, j, k, n;
+	bool changed;
+
+	findvars(fn);
+	n = fn->setsiz;
+	xfree(fn->sets);
+	fn->sets = xcalloc(2 * fn->nblocks * n + 1, sizeof(*fn->sets));
+	for (i = 0; i < fn->nblocks; ++i) {
+		bp = &fn->blocks[i];
+		bp->in = &fn->sets[2*i * n];
+		bp->out = bp->in + n;
+	}
+	if (n == 0)
+		return;
+
+	set = xmalloc(n * sizeof(*set));
+	do {
+		changed = 0;
+		for (i = fn->nrpo; i-- > 0; ) {
+			bp = fn->rpo[i];
+			for (j = 0; j < bp->nsuccs; ++j) {
+				in = bp->succs[j]->in;
+				for (k = 0; k < n; ++k)
+					bp->out[k] |= in[k];
+			}
+			blocklive(fn, bp, set);
+			if (memcmp(set, bp->in, n * sizeof(*set))) {
+				memcpy(bp->in, set, n * sizeof(*set));
+				changed = 1;
+			}
+		}
+	} while (changed);
+	xfree(set);
+}
+
+/*
+ * Remove the assignments to variables that are not live after
+ * them. Removing an assignment can kill the variables that it
+ * used, so it is repeated until nothing changes. The control
+ * flow graph and the liveness are valid at the end.
+ */
+void
+deadstores(Func *fn)
+{
+	Block *bp;
+	Node **body, *np;
+	unsigned long *set;
+	unsigned i, j, removed;
+	bool *dead;
+	int idx;
+
+	for (;;) {
+		liveness(fn);
+		if (fn->nvars == 0)
+			return;
+
+		body = fn->body;
+		dead = xcalloc(fn->nstmts, sizeof(*dead));
+		set = xmalloc(fn->setsiz * sizeof(*set));
+		removed = 0;
+		for (i = 0; i < fn->nrpo; ++i) {
+			bp = fn->rpo[i];
+			memcpy(set, bp->out, fn->setsiz * sizeof(*set));
+			for (j = bp->end; j-- > bp->begin; ) {
+				np = body[j];
+				idx = target(fn, np);
+				if (idx >= 0 && !islive(set, idx) && pure(np->right)) {
+					dead[j] = 1;
+					++removed;
+					continue;
+				}
+				transfer(fn, np, set);
+			}
+		}
+		xfree(set);
+
+		if (removed > 0) {
+			for (i = j = 0; i < fn->nstmts; ++i) {
+				if (!dead[i])
+					body[j++] = body[i];
+			}
+			fn->nstmts = j;
+		}
+		xfree(dead);
+		if (removed == 0)
+			return;
+		buildcfg(fn);
+	}
+}
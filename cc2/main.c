@@ -1,14 +1,20 @@
 
+#include <errno.h>
+#include <pthread.h>
 #include <stdarg.h>
 #include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
 #include "../inc/cc.h"
 
 #include "cc2.h"
 #include "error.h"
 
+#define NR_JOBS 16
+
 char odebug;
 
 void
@@ -25,32 +31,189 @@ error(unsigned nerror, ...)
 	exit(1);
 }
 
-bool
-moreinput(void)
+/*
+ * The functions are parsed in order, because they share the global
+ * symbols, but the rest of the work only needs the Func of every
+ * function, so it can be done by a pool of workers. The functions
+ * not written yet are kept in a list in the order of the source,
+ * and they are written when all the previous ones are written.
+ * There are at most NR_JOBS functions in the list.
+ */
+static Func *head, *tail, *todo;
+static int njobs, nworkers, quit;
+static pthread_t *workers;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t ready = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t finished = PTHREAD_COND_INITIALIZER;
+
+static void
+compile(Func *fn)
 {
-	int c;
+	optimize(fn);
+	buildcfg(fn);
+	deadstores(fn);
+	regalloc(fn);
+	generate(fn);
+	peephole(fn);
+	writeout(fn);
+}
 
-repeat:
-	if (feof(stdin))
-		return 0;
-	if ((c = getchar()) == '\n' || c == EOF)
-		goto repeat;
-	ungetc(c, stdin);
-	return 1;
+static void
+putfun(Func *fn)
+{
+	if (fwrite(fn->out, 1, fn->outlen, stdout) != fn->outlen)
+		error(EFERROR, strerror(errno));
+	delfun(fn);
 }
 
-int
-main(void)
+static void *
+worker(void *arg)
 {
-	fputs("cc2 is not updated with the output of cc1", stderr);
-	exit(1);
+	Func *fn;
+
+	pthread_mutex_lock(&lock);
+	for (;;) {
+		while (!todo && !quit)
+			pthread_cond_wait(&ready, &lock);
+		if ((fn = todo) == NULL)
+			break;
+		todo = fn->next;
+		pthread_mutex_unlock(&lock);
+
+		compile(fn);
+
+		pthread_mutex_lock(&lock);
+		fn->done = 1;
+		pthread_cond_signal(&finished);
+	}
+	pthread_mutex_unlock(&lock);
+	return NULL;
+}
+
+/* write the functions already generated, called with the lock */
+static void
+flushjobs(void)
+{
+	Func *fn;
+
+	while ((fn = head) != NULL && fn->done) {
+		if ((head = fn->next) == NULL)
+			tail = NULL;
+		--njobs;
+		pthread_mutex_unlock(&lock);
+		putfun(fn);
+		pthread_mutex_lock(&lock);
+	}
+}
+
+static void
+addjob(Func *fn)
+{
+	if (nworkers == 0) {
+		compile(fn);
+		putfun(fn);
+		return;
+	}
+
+	pthread_mutex_lock(&lock);
+	for (flushjobs(); njobs == NR_JOBS; flushjobs())
+		pthread_cond_wait(&finished, &lock);
+	if (tail)
+		tail->next = fn;
+	else
+		head = fn;
+	tail = fn;
+	if (!todo)
+		todo = fn;
+	++njobs;
+	pthread_cond_signal(&ready);
+	pthread_mutex_unlock(&lock);
+}
+
+void
+initjobs(int n)
+{
+	if (n <= 0 || nworkers > 0)
+		return;
+	workers = xmalloc(n * sizeof(*workers));
+	for (nworkers = 0; nworkers < n; ++nworkers) {
+		if (pthread_create(&workers[nworkers], NULL, worker, NULL))
+			die("error creating worker threads");
+	}
+}
+
+/* wait for all the functions and stop the workers */
+void
+endjobs(void)
+{
+	int i;
+
+	if (nworkers == 0)
+		return;
+
+	pthread_mutex_lock(&lock);
+	for (flushjobs(); njobs > 0; flushjobs())
+		pthread_cond_wait(&finished, &lock);
+	quit = 1;
+	pthread_cond_broadcast(&ready);
+	pthread_mutex_unlock(&lock);
+
+	for (i = 0; i < nworkers; ++i)
+		pthread_join(workers[i], NULL);
+	xfree(workers);
+	nworkers = 0;
+}
+
+/*
+ * Generate the code of all the functions in the input,
+ * which must be set with setinput() before
+ */
+void
+codegen(void)
+{
+	Func *fn;
+
 	while (moreinput()) {
-		parse();
-		optimize();
-		addable();
-		generate();
-		peephole();
-		writeout();
+		if ((fn = parse()) != NULL)
+			addjob(fn);
+	}
+}
+
+int
+main(int argc, char *argv[])
+{
+	char *buf = NULL;
+	size_t len = 0, siz = 0;
+	ssize_t n;
+
+	atexit(memstats);
+	atexit(peepstats);
+
+	for (--argc, ++argv; argc > 0; --argc, ++argv) {
+		if (!strcmp(*argv, "-c"))
+			initobj();
+		else if (!strncmp(*argv, "-j", 2))
+			initjobs(atoi(*argv + 2));
+		else
+			die("usage: cc2 [-c] [-jworkers]");
+	}
+
+	for (;;) {
+		if (len == siz) {
+			siz = (siz) ? 2*siz : BUFSIZ;
+			buf = xrealloctag(buf, siz, MEM_INPUT);
+		}
+		if ((n = read(0, buf + len, siz - len)) == 0)
+			break;
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			error(EFERROR, strerror(errno));
+		}
+		len += n;
 	}
+	setinput(buf, len);
+	codegen();
+	endjobs();
 	return 0;
 }
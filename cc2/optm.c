@@ -8,9 +8,42 @@
 
 #include <stdio.h>
 
+/*
+ * The low bytes of these values only depend on the low bytes of
+ * their operands, so they can be computed in a smaller size
+ */
+static bool
+narrows(Node *np)
+{
+	switch (np->op) {
+	case OADD:
+	case OSUB:
+	case OMUL:
+	case OBAND:
+	case OBOR:
+	case OBXOR:
+	case OSHL:
+	case ONEG:
+	case OCPL:
+	case OCOMMA:
+	case OCOLON:
+	case OCAST:
+	case AUTO:
+	case PAR:
+	case MEM:
+	case REG:
+	case CONST:
+		return (np->type.flags & INTF) != 0;
+	default:
+		return 0;
+	}
+}
+
 static Node *
 optcasts(Node *np, Type *tp)
 {
+	Node *p;
+
 	if (!np)
 		return NULL;
 
@@ -18,15 +51,40 @@ repeat:
 	switch (np->op) {
 	case OCAST:
 		/* TODO: be careful with the sign */
-		if (np->type.flags&INTF && np->type.size >= tp->size) {
-			np = np->left;
+		p = np->left;
+		if (np->type.flags&INTF && np->type.size >= tp->size &&
+		    p->type.size >= tp->size &&
+		    (p->type.size == tp->size || narrows(p))) {
+			np = p;
 			goto repeat;
 		}
 		break;
+	case OPTR:
+		/* the size of the address does not change */
+		if (np->type.size > tp->size)
+			np->type = *tp;
+		np->left = optcasts(np->left, &np->left->type);
+		return np;
 	case OASSIG:
 		tp = &np->type;
 		break;
+	case OCALL:
+		/* the arguments have the types of the parameters */
+		for (p = np->right; p; p = p->right)
+			p->left = optcasts(p->left, &p->type);
+		return np;
+	case OASK:
+		np->left = optcasts(np->left, &np->left->type);
+		np->right = optcasts(np->right, &np->type);
+		return np;
 	default:
+		if (!narrows(np)) {
+			if (np->left)
+				np->left = optcasts(np->left, &np->left->type);
+			if (np->right)
+				np->right = optcasts(np->right, &np->right->type);
+			return np;
+		}
 		if (np->type.size > tp->size)
 			np->type = *tp;
 		break;
@@ -45,7 +103,7 @@ opt(Node *np)
 }
 
 void
-optimize(void)
+optimize(Func *fn)
 {
-	apply(opt);
+	apply(fn, opt);
 }
@@ -10,36 +10,39 @@
 
 #include "cc2.h"
 
-#define MAXLINE 200
-#define NR_STACKSIZ 32
-#define NR_NODEPOOL 128
-#define NR_EXPRESSIONS 64
+#define NR_NODEBLK 128
 
 enum {
-	LOCAL, GLOBAL, PARAMETER
+	LOCAL, GLOBAL
 };
 
-Symbol *curfun;
-static Node *stack[NR_STACKSIZ], **stackp;
-static Node *listexp[NR_EXPRESSIONS], **listp;
-static Node nodepool[NR_NODEPOOL], *newp;
+static Func *curfun;
+static Symbol *lastfun;
+static bool inpars;
+static Node **stack;
+static unsigned nstack, maxstack;
 
 
+/* the alignments are the ones of cc1, the Z80 does not need them */
 static Type Funct = {
 	.letter = L_FUNCTION,
 };
 
+static Type l_void = {
+	.letter = L_VOID,
+};
+
 static Type l_int8 = {
 	.letter = L_INT8,
 	.size = 1,
-	.align = 2,
+	.align = 1,
 	.flags = SIGNF | INTF
 };
 
 static Type l_int16 = {
 	.letter = L_INT16,
 	.size = 2,
-	.align = 2,
+	.align = 1,
 	.flags = SIGNF | INTF
 
 };
@@ -47,7 +50,7 @@ static Type l_int16 = {
 static Type l_int32 = {
 	.letter = L_INT32,
 	.size = 4,
-	.align = 4,
+	.align = 1,
 	.flags = SIGNF | INTF
 
 };
@@ -55,7 +58,7 @@ static Type l_int32 = {
 static Type l_int64 = {
 	.letter = L_INT64,
 	.size = 8,
-	.align = 8,
+	.align = 1,
 	.flags = SIGNF | INTF
 
 };
@@ -63,52 +66,46 @@ static Type l_int64 = {
 static Type l_uint8 = {
 	.letter = L_UINT8,
 	.size = 1,
-	.align = 2,
+	.align = 1,
 	.flags =  INTF
 };
 
 static Type l_uint16 = {
 	.letter = L_UINT16,
 	.size = 2,
-	.align = 2,
+	.align = 1,
 	.flags =  INTF
 };
 
 static Type l_uint32 = {
 	.letter = L_UINT32,
 	.size = 4,
-	.align = 4,
+	.align = 1,
 	.flags =  INTF
 };
 
 static Type l_uint64 = {
 	.letter = L_UINT64,
 	.size = 8,
-	.align = 8,
+	.align = 1,
 	.flags =  INTF
 };
 
-static void cast(char *), operator(char *), assignment(char *), increment(char *),
-            globvar(char *), localvar(char *), paramvar(char *), label(char *),
-            immediate(char *), unary(char *), oreturn(char *);
-
-/*TODO: Remove hardcoded symbols */
-
-static void (*optbl[])(char *) = {
-	[L_INT8] = cast,
-	[L_INT16] = cast,
-	[L_INT32] = cast,
-	[L_INT64] = cast,
-	[L_UINT8] = cast,
-	[L_UINT16] = cast,
-	[L_UINT32] = cast,
-	[L_UINT64] = cast,
-	[L_BOOL] = cast,
-	[L_FLOAT] = cast,
-	[L_DOUBLE] = cast,
-	[L_LDOUBLE] = cast,
-	[L_POINTER] = cast,
-	[L_VOID] = cast,
+static Type l_ptr = {
+	.letter = L_POINTER,
+	.size = 2,
+	.align = 2
+};
+
+static void cast(int), operator(int), assignment(int), increment(int),
+            globvar(int), localvar(int), label(int),
+            immediate(int), unary(int), oreturn(int), jump(int),
+            oswitch(int), table(int), loop(int), call(int),
+            field(int), member(int), ternary(int);
+
+/* the letters of the operators are the ones written by cc1 */
+static void (*optbl[])(int) = {
+	['g'] = cast,
 	['+'] = operator,
 	['%'] = operator,
 	['-'] = operator,
@@ -122,27 +119,39 @@ static void (*optbl[])(char *) = {
 	[':'] = assignment,
 	[';'] = increment,
 	['Y'] = globvar,
+	['X'] = globvar,
 	['A'] = localvar,
-	['K'] = localvar,
+	['R'] = localvar,
 	['T'] = localvar,
 	['G'] = globvar,
-	['P'] = paramvar,
 	['L'] = label,
 	['#'] = immediate,
 	['@'] = unary,
-	['a'] = unary,
+	['\''] = unary,
 	['<'] = operator,
 	['>'] = operator,
 	[']'] = operator,
 	['['] = operator,
 	['='] = operator,
-	['!'] = unary,
+	['!'] = operator,
+	['a'] = operator,
 	['y'] = oreturn,
-	['j'] = NULL,
+	['j'] = jump,
+	['s'] = oswitch,
+	['t'] = table,
+	['v'] = jump,
+	['f'] = jump,
+	['b'] = loop,
+	['e'] = loop,
 	['o'] = operator,
 	['_'] = unary,
 	['~'] = unary,
 	[','] = operator,
+	['p'] = unary,
+	['c'] = call,
+	['.'] = field,
+	['M'] = member,
+	['?'] = ternary,
 	['\177'] = NULL
 };
 
@@ -164,79 +173,230 @@ prtree(Node *np)
 }
 
 void
-apply(Node *(*fun)(Node *))
+apply(Func *fn, Node *(*fun)(Node *))
 {
 	Node **list, *np;
 
-	for (list = curfun->u.f.body; np = *list; ++list)
-		*list++ = (*fun)(np);
+	for (list = fn->body; np = *list; ++list)
+		*list = (*fun)(np);
 }
 
-static Symbol *
-parameter(char *num)
+/*
+ * The input is a buffer in memory, filled by main() from stdin or
+ * by the driver with the IR of one function. It can be the text
+ * form of the IR or the binary form, which begins with IR_MAGIC.
+ * The records are scanned in place, and the handlers read their
+ * fields with readc(), readnum() and readname(), which hide the
+ * differences between both forms. Separators are skipped in both
+ * forms, because they are not used in the binary form.
+ */
+static unsigned char *inp, *inend;
+static bool binary, eol;
+static int subop;
+
+/* value of hexadecimal digits plus one */
+static unsigned char digits[256] = {
+	['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5,
+	['5'] = 6, ['6'] = 7, ['7'] = 8, ['8'] = 9, ['9'] = 10,
+	['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15,
+	['F'] = 16
+};
+
+void
+setinput(char *buf, size_t len)
 {
-	static Symbol tbl[NR_FUNPARAM];
-	Symbol *sym;
-	unsigned i = atoi(num);
+	inp = (unsigned char *) buf;
+	inend = inp + len;
+}
 
-	if (!curfun)
+bool
+moreinput(void)
+{
+	while (inp < inend && *inp == '\n')
+		++inp;
+	return inp < inend;
+}
+
+static int
+getbyte(void)
+{
+	return (inp < inend) ? *inp++ : EOF;
+}
+
+static int
+readc(void)
+{
+	int c;
+
+	if (eol)
+		return '\n';
+	if (subop) {
+		c = subop;
+		subop = 0;
+		return c;
+	}
+	while ((c = getbyte()) == '\t')
+		;
+	if (c == EOF)
 		error(ESYNTAX);
-	if (i >= NR_FUNPARAM)
-		error(EPARNUM);
-	sym = &tbl[i];
+	if (c & 0x80) {
+		/* only in the binary form, see emitbin() in cc1 */
+		subop = c & 0x7F;
+		c = OASSIG;
+	} else if (c == '\n') {
+		eol = 1;
+	}
+	return c;
+}
+
+static TUINT
+readnum(int base)
+{
+	TUINT u = 0;
+	int c, d, shift;
+
+	if (!binary) {
+		while (inp < inend && (d = digits[*inp]) != 0 && d <= base) {
+			u = u*base + d-1;
+			++inp;
+		}
+		return u;
+	}
+	for (shift = 0; ; shift += 7) {
+		if ((c = getbyte()) == EOF)
+			error(ESYNTAX);
+		u |= (TUINT) (c & 0x7F) << shift;
+		if ((c & 0x80) == 0)
+			return u;
+	}
+}
+
+static char *
+readname(void)
+{
+	unsigned char *bp;
+	size_t len;
+	char *s;
+
+	if (binary) {
+		len = readnum(10);
+		if (inend - inp < len)
+			error(ESYNTAX);
+	} else {
+		while (inp < inend && *inp == '\t')
+			++inp;
+		for (bp = inp; bp < inend && *bp != '\t' && *bp != '\n'; ++bp)
+			;
+		len = bp - inp;
+	}
+	if (len == 0)
+		return NULL;
+
+	s = xmalloc(len + 1);
+	memcpy(s, inp, len);
+	s[len] = '\0';
+	inp += len;
+	return s;
+}
+
+/*
+ * Symbols are indexed by the id given by cc1, which is a dense
+ * 32 bit counter, so the tables grow on demand instead of having
+ * a fixed size. They store pointers because nodes keep references
+ * to the symbols, and they cannot be moved when the table grows.
+ */
+struct symtab {
+	unsigned nr;
+	Symbol **tbl;
+};
+
+static Symbol *
+getsym(struct symtab *tab, unsigned i)
+{
+	Symbol *sym, **bp;
+	unsigned n;
+
+	if (i >= tab->nr) {
+		n = (i >= 2*tab->nr) ? i+1 : 2*tab->nr;
+		tab->tbl = xrealloctag(tab->tbl, n * sizeof(Symbol *),
+		                       MEM_SYMBOL);
+		for (bp = &tab->tbl[tab->nr]; bp < &tab->tbl[n]; ++bp)
+			*bp = NULL;
+		tab->nr = n;
+	}
+	if ((sym = tab->tbl[i]) == NULL)
+		sym = tab->tbl[i] = xcalloctag(1, sizeof(*sym), MEM_SYMBOL);
 	sym->id = i;
 	return sym;
 }
 
 static Symbol *
-local(char *num)
+local(unsigned id)
 {
-	static Symbol tbl[NR_INT_IDENT];
-	Symbol *sym;
-	unsigned i = atoi(num);
+	static struct symtab tab;
 
 	if (!curfun)
 		error(ESYNTAX);
-	if (i >= NR_INT_IDENT)
-		error(EINTNUM);
-	sym = &tbl[i];
-	sym->id = i;
-	return sym;
+	return getsym(&tab, id);
 }
 
 static Symbol *
-global(char *num)
+global(unsigned id)
 {
-	static Symbol tbl[NR_EXT_IDENT];
-	Symbol *sym;
-	unsigned i = atoi(num);
+	static struct symtab tab;
 
-	if (i >= NR_EXT_IDENT)
-		error(EEXTNUM);
+	return getsym(&tab, id);
+}
 
-	sym = &tbl[i];
-	sym->id = i;
-	return sym;
+/*
+ * The arrays, structs and unions are declared before they are
+ * used, and their types are kept in the type of a symbol of
+ * their own table. The members are in another table, with their
+ * offset, because cc1 does not give it.
+ */
+static Symbol *
+aggregate(unsigned id)
+{
+	static struct symtab tab;
+
+	return getsym(&tab, id);
+}
+
+static Symbol *
+fieldsym(unsigned id)
+{
+	static struct symtab tab;
+
+	return getsym(&tab, id);
 }
 
+/*
+ * The nodes of a function are taken from blocks of NR_NODEBLK
+ * nodes, which are only freed when the function is written. The
+ * blocks are zeroed because cgen.c expects the flags to be clear.
+ */
 static Node *
-newnode(void)
+newnode(Func *fn)
 {
-	if (newp == &nodepool[NR_NODEPOOL])
-		error(ENODEOV);
-	return newp++;
+	unsigned n;
+
+	if ((n = fn->nrnodes / NR_NODEBLK) == fn->nrblks) {
+		fn->nodeblks = xrealloc(fn->nodeblks,
+		                        ++fn->nrblks * sizeof(Node *));
+		fn->nodeblks[n] = xcalloctag(NR_NODEBLK, sizeof(Node), MEM_NODE);
+	}
+	return &fn->nodeblks[n][fn->nrnodes++ % NR_NODEBLK];
 }
 
 Node *
-imm(TINT i)
+imm(Func *fn, TINT i)
 {
-	Node *np = newnode();
+	Node *np = newnode(fn);
 
 	np->op = CONST;
 	np->type = l_int16;
-	/* FIX: memory leak */
-	np->sym = xmalloc(sizeof(Symbol));
-	np->sym->u.imm = i;
+	np->sym = NULL;
+	np->imm = i;
 	np->left = np->right = NULL;
 	return np;
 }
@@ -244,23 +404,35 @@ imm(TINT i)
 static void
 push(Node *np)
 {
-	if (stackp == &stack[NR_STACKSIZ])
-		error(ESTACKO);
-	*stackp++ = np;
+	if (nstack == maxstack) {
+		maxstack = (maxstack) ? 2*maxstack : 32;
+		stack = xrealloc(stack, maxstack * sizeof(Node *));
+	}
+	stack[nstack++] = np;
 }
 
 static Node *
 pop(void)
 {
-	if (stackp == stack)
+	if (nstack == 0)
 		error(ESTACKU);
-	return *--stackp;
+	return stack[--nstack];
+}
+
+static void
+addstmt(Func *fn, Node *np)
+{
+	if (fn->nstmts == fn->maxstmts) {
+		fn->maxstmts = (fn->maxstmts) ? 2*fn->maxstmts : 16;
+		fn->body = xrealloc(fn->body, fn->maxstmts * sizeof(Node *));
+	}
+	fn->body[fn->nstmts++] = np;
 }
 
 static Type *
-gettype(char *type)
+gettype(int letter)
 {
-	switch (type[0]) {
+	switch (letter) {
 	case L_INT8:
 		return &l_int8;
 	case L_INT16:
@@ -277,32 +449,40 @@ gettype(char *type)
 		return &l_uint32;
 	case L_UINT64:
 		return &l_uint64;
+	case L_POINTER:
+		return &l_ptr;
+	case L_VOID:
+		return &l_void;
 	case L_FUNCTION:
+		readnum(10);
 		return &Funct;
+	case L_ARRAY:
+	case L_STRUCT:
+	case L_UNION:
+		return &aggregate(readnum(10))->u.v.type;
 	default:
 		error(ETYPERR);
 	}
 }
 
 static Symbol *
-symbol(uint8_t t, char *token)
+symbol(uint8_t t, int kind)
 {
 	Symbol *sym;
-	static Symbol *(*tbl[3])(char *)= {
+	static Symbol *(*tbl[2])(unsigned)= {
 		[LOCAL] = local,
-		[GLOBAL] = global,
-		[PARAMETER] = parameter
+		[GLOBAL] = global
 	};
-	sym = (*tbl[t])(token+1);
-	sym->kind = *token;
+	sym = (*tbl[t])(readnum(10));
+	sym->kind = kind;
 	return sym;
 }
 
 static void
-variable(uint8_t t, char *token)
+variable(uint8_t t, int kind)
 {
-	Node *np = newnode();
-	Symbol *sym = symbol(t, token);
+	Node *np = newnode(curfun);
+	Symbol *sym = symbol(t, kind);
 
 	np->sym = sym;
 	np->op = sym->u.v.sclass;
@@ -312,76 +492,71 @@ variable(uint8_t t, char *token)
 }
 
 static void
-localvar(char *token)
+localvar(int op)
 {
-	variable(LOCAL, token);
+	variable(LOCAL, op);
 }
 
 static void
-globvar(char *token)
+globvar(int op)
 {
-	variable(GLOBAL, token);
+	variable(GLOBAL, op);
 }
 
 static void
-paramvar(char *token)
-{
-	variable(PARAMETER, token);
-}
-
-static void
-immediate(char *token)
+immediate(int op)
 {
 	/* TODO: check type of immediate */
-	push(imm(atoi(token+2)));
+	readc();
+	push(imm(curfun, readnum(16)));
 }
 
 static void
-unary(char *token)
+unary(int op)
 {
-	Node *np = newnode();
+	Node *np = newnode(curfun);
 
 	np->right = NULL;
 	np->left = pop();
-	np->type = *gettype(token+1);
-	np->op = token[0];
+	np->type = *gettype(readc());
+	np->op = op;
 	push(np);
 }
 
 static void
-operator(char *token)
+operator(int op)
 {
-	Node *np = newnode();
+	Node *np = newnode(curfun);
 
 	np->right = pop();
 	np->left = pop();
-	np->type = *gettype(token+1);
-	np->op = token[0];
+	np->type = *gettype(readc());
+	np->op = op;
 	push(np);
 }
 
 static void
-label(char *token)
+label(int op)
 {
-	Node *np = newnode();
+	Node *np = newnode(curfun);
 
 	np->left = np->right = NULL;
 	np->op = LABEL;
-	np->sym = local(token);
+	np->sym = local(readnum(10));
 	push(np);
 }
 
 static void
-increment(char *token)
+increment(int op)
 {
-	Node *np = newnode();
+	Node *np = newnode(curfun);
 
 	np->right = pop();
 	np->left = pop();
-	np->type = *gettype(token+2);
-	np->op = token[0];
-	switch (np->subop = token[1]) {
+	np->op = op;
+	switch (np->subop = readc()) {
 	case '-': case '+':
+		np->type = *gettype(readc());
 		push(np);
 		break;
 	default:
@@ -390,76 +565,174 @@ increment(char *token)
 }
 
 static void
-assignment(char *token)
+assignment(int op)
 {
-	Node *np = newnode();
+	Node *np = newnode(curfun);
+	int c;
 
 	np->right = pop();
 	np->left = pop();
-	np->op = *token;
-	switch (*++token) {
+	np->op = op;
+	switch (c = readc()) {
+	case 'i':
+	case 'd':
+		/* x++ and x-- of cc1 */
+		np->op = OINC;
+		np->subop = (c == 'i') ? OADD : OSUB;
+		c = readc();
+		break;
 	case OADD: case OSUB: case OINC:  case OMOD: case ODIV:
 	case OSHL: case OSHR: case OBAND: case OBOR: case OBXOR:
-		np->subop = *++token;
-	default:
-		np->type = *gettype(token);
+	case '*':
+		np->subop = c;
+		c = readc();
 		break;
 	}
+	np->type = *gettype(c);
 	push(np);
 }
 
 static void
-cast(char *token)
+cast(int op)
 {
-	Node *np = newnode();
+	Node *np = newnode(curfun);
 
 	np->right = NULL;
 	np->left = pop();
 	np->op = OCAST;
-	np->type = *gettype(token+1);
+	np->type = *gettype(readc());
 	push(np);
 }
 
+/*
+ * The arguments are OPAR nodes over the stack, and they are
+ * linked by right in the order of the source, beginning in the
+ * right of the call
+ */
 static void
-expr(char *token)
+call(int op)
 {
-	void (*fun)(char *);
-	unsigned c;
+	Node *np = newnode(curfun), *par = NULL, *p;
 
-	do {
-		if ((c = token[0]) > 0x7f || (fun = optbl[c]) == NULL)
-			error(ESYNTAX);
-		(*fun)(token);
-	} while (token = strtok(NULL, "\t"));
+	while (nstack > 0 && (p = stack[nstack-1])->op == OPAR) {
+		--nstack;
+		p->right = par;
+		par = p;
+	}
+	np->left = pop();
+	np->right = par;
+	np->op = OCALL;
+	np->type = *gettype(readc());
+	push(np);
+}
+
+static void
+member(int op)
+{
+	push(imm(curfun, fieldsym(readnum(10))->u.v.off));
+}
+
+/* x.m is *(&x + offset of m) */
+static void
+field(int op)
+{
+	Node *np = newnode(curfun), *off = pop(), *lp = pop(), *addr, *sum;
+
+	switch (lp->op) {
+	case OPTR:
+		addr = lp->left;
+		break;
+	case AUTO:
+	case PAR:
+	case MEM:
+		addr = newnode(curfun);
+		addr->op = OADDR;
+		addr->type = l_ptr;
+		addr->left = lp;
+		addr->right = NULL;
+		break;
+	default:
+		error(ETYPERR);
+	}
+	sum = newnode(curfun);
+	sum->op = OADD;
+	sum->type = l_ptr;
+	sum->left = addr;
+	sum->right = off;
+
+	np->op = OPTR;
+	np->type = *gettype(readc());
+	np->left = sum;
+	np->right = NULL;
+	push(np);
+}
+
+/* the two values of x ? a : b are in an OCOLON */
+static void
+ternary(int op)
+{
+	Node *np = newnode(curfun), *colon = newnode(curfun);
+
+	colon->right = pop();
+	colon->left = pop();
+	colon->op = OCOLON;
+	np->right = colon;
+	np->left = pop();
+	np->op = OASK;
+	np->type = colon->type = *gettype(readc());
+	push(np);
+}
+
+static void
+token(int c)
+{
+	void (*fun)(int);
+
+	if (c > 0x7f || (fun = optbl[c]) == NULL)
+		error(ESYNTAX);
+	(*fun)(c);
 }
 
 static void
-expression(char *token)
+expr(void)
+{
+	int c;
+
+	while ((c = readc()) != '\n')
+		token(c);
+}
+
+static void
+expression(int c)
 {
 	Node *np;
 
 	if (!curfun)
 		error(ESYNTAX);
 
-	expr(token);
+	/* an expression begins with an operand, so r is a return */
+	if ((c = readc()) == 'r')
+		c = ORET;
+	if (c != '\n')
+		token(c);
+	expr();
 
 	np = pop();
-	if (stackp != stack)
+	if (nstack != 0)
 		error(EEXPBAL);
-	if (listp == &listexp[NR_EXPRESSIONS])
-		error(EEXPROV);
-	*listp++ = np;
+	addstmt(curfun, np);
 }
 
 static void
-oreturn(char *token)
+oreturn(int op)
 {
-	Node *np = newnode(), *lp;
+	Node *np = newnode(curfun), *lp;
+	unsigned n = nstack;
 
-	np->op = token[0];
+	np->op = op;
 
-	if (token = strtok(NULL, "\t")) {
-		expr(token);
+	expr();
+	if (nstack != n) {
 		lp = pop();
 		np->left = lp;
 		np->type = lp->type;
@@ -470,41 +743,143 @@ oreturn(char *token)
 	push(np);
 }
 
+/* the label of jumps, switches and cases */
+static Symbol *
+target(void)
+{
+	if (readc() != 'L')
+		error(ESYNTAX);
+	return local(readnum(10));
+}
+
+/*
+ * Jumps, switches and the entries of switch tables are kept
+ * as statements, with the label in sym and the expression,
+ * if there is one, in left.
+ */
 static void
-deflabel(char *token)
+jump(int op)
 {
-	Symbol *sym;
+	Node *np = newnode(curfun);
+	unsigned n = nstack;
+
+	np->op = op;
+	np->sym = target();
+	expr();
+	np->left = (nstack != n) ? pop() : NULL;
+	np->right = NULL;
+	push(np);
+}
+
+static void
+oswitch(int op)
+{
+	Node *np = newnode(curfun);
+
+	np->op = op;
+	np->sym = target();
+	expr();
+	np->left = pop();
+	np->right = NULL;
+	push(np);
+}
+
+static void
+table(int op)
+{
+	Node *np = newnode(curfun);
+
+	if (readc() != '#')
+		error(ESYNTAX);
+	np->op = op;
+	np->imm = readnum(16);
+	np->left = np->right = NULL;
+	push(np);
+}
+
+static void
+loop(int op)
+{
+	Node *np = newnode(curfun);
+
+	np->op = op;
+	np->left = np->right = NULL;
+	push(np);
+}
+
+static void
+labeldcl(int c)
+{
+	Node *np;
 
 	if (!curfun)
 		error(ESYNTAX);
-	sym = local(token);
+	np = newnode(curfun);
+	np->op = LABEL;
+	np->sym = local(readnum(10));
+	np->left = np->right = NULL;
+	addstmt(curfun, np);
+}
+
+static Func *
+newfun(Symbol *sym)
+{
+	static unsigned id = 1000;
+	Func *fn = xcalloc(1, sizeof(*fn));
+
+	/* u.f shares the storage with the type of the symbol */
+	sym->u.f.locals = sym->u.f.params = 0;
+	fn->sym = sym;
+	fn->retlabel.kind = LABEL;
+	fn->retlabel.id = id++;
+	return fn;
+}
+
+void
+delfun(Func *fn)
+{
+	unsigned i;
+
+	xfree(fn->prog);
+	xfree(fn->blocks);
+	xfree(fn->rpo);
+	xfree(fn->edges);
+	xfree(fn->regvars);
+	xfree(fn->vars);
+	xfree(fn->sets);
+	for (i = 0; i < fn->nrblks; ++i)
+		xfree(fn->nodeblks[i]);
+	xfree(fn->nodeblks);
+	for (i = 0; i < fn->nlabels; ++i) {
+		xfree(fn->labels[i]->name);
+		xfree(fn->labels[i]);
+	}
+	xfree(fn->labels);
+	xfree(fn->body);
+	xfree(fn->out);
+	xfree(fn);
 }
 
 static Symbol *
-declaration(uint8_t t, char class, char *token)
+declaration(uint8_t t, char class, int kind)
 {
-	Symbol *sym = symbol(t, token);
-	char *s;
+	Symbol *sym = symbol(t, kind);
 
-	free(sym->name);
+	xfree(sym->name);
 	memset(sym, 0, sizeof(*sym));
 	sym->u.v.sclass = class;
-
-	if ((s = strtok(NULL, "\t")) == NULL)
-		error(ESYNTAX);
-	sym->u.v.type = *gettype(s);
-	if ((s = strtok(NULL, "\t")) != NULL)
-		sym->name = xstrdup(s);
+	sym->u.v.type = *gettype(readc());
+	sym->name = readname();
 
 	return sym;
 }
 
 static void
-globdcl(char *token)
+globdcl(int c)
 {
-	Symbol *sym = declaration(GLOBAL, MEM, token);
+	Symbol *sym = declaration(GLOBAL, MEM, c);
 
-	switch (token[0]) {
+	switch (c) {
 	case 'X':
 		sym->extrn = 1;
 		break;
@@ -513,89 +888,202 @@ globdcl(char *token)
 		break;
 	}
 
-	if (sym->u.v.type.letter != L_FUNCTION)
-		return;
-
-	if (curfun)
-		error(ESYNTAX);
-
-	curfun = sym;
-	sym->u.f.body = listp = listexp;
-	newp = nodepool;
+	/* the body, if there is one, comes in the next line */
+	lastfun = (sym->u.v.type.letter == L_FUNCTION) ? sym : NULL;
 }
 
+/*
+ * The frame pointer IX points to the saved IX, and the return
+ * address is after it, so the parameters begin at IX+4 and the
+ * locals are below IX. The parameters are PAR, so they are not
+ * taken for registers.
+ */
 static void
-paramdcl(char *token)
+paramdcl(int c)
 {
-	Symbol *sym = declaration(PARAMETER, AUTO, token);
-	sym->u.v.off = -curfun->u.f.params;
-	curfun->u.f.params += sym->u.v.type.size;
+	Symbol *sym = declaration(LOCAL, PAR, c);
+	Symbol *fun = curfun->sym;
+	uint8_t size = sym->u.v.type.size;
+
+	/* stack elements are 2 byte multiple */
+	if (size == 1)
+		++size;
+	sym->u.v.off = 4 + fun->u.f.params;
+	fun->u.f.params += size;
 }
 
 static void
-localdcl(char *token)
+localdcl(int c)
 {
-	Symbol *sym = declaration(LOCAL, token[0], token);
-	char sclass = *token;
+	Symbol *sym;
+
+	if (!curfun)
+		error(ESYNTAX);
+	if (inpars) {
+		paramdcl(c);
+		return;
+	}
+	sym = declaration(LOCAL, (c == 'T') ? MEM : AUTO, c);
 
-	if (sclass == 'A' || sclass == 'R') {
+	if (c == 'A' || c == 'R') {
 		uint8_t size = sym->u.v.type.size;
 		/* stack elements are 2 byte multiple */
 		if (size == 1)
 			++size;
-		curfun->u.f.locals += size;
-		sym->u.v.off = curfun->u.f.locals;
+		curfun->sym->u.f.locals += size;
+		sym->u.v.off = -curfun->sym->u.f.locals;
 	}
 }
 
-void
+static Symbol *curaggr;
+
+/* V id type #n */
+static void
+arraydcl(int c)
+{
+	Symbol *sym = aggregate(readnum(10));
+	Type *tp = gettype(readc());
+
+	if (readc() != '#')
+		error(ESYNTAX);
+	sym->u.v.type.letter = L_ARRAY;
+	sym->u.v.type.align = tp->align;
+	sym->u.v.type.flags = 0;
+	sym->u.v.type.size = tp->size * readnum(10);
+}
+
+/* S id name and U id name, followed by the members */
+static void
+aggrdcl(int c)
+{
+	Symbol *sym = aggregate(readnum(10));
+
+	xfree(readname());
+	sym->u.v.type.letter = c;
+	sym->u.v.type.size = 0;
+	sym->u.v.type.align = 1;
+	sym->u.v.type.flags = 0;
+	curaggr = sym;
+}
+
+/* M id type name, with the layout of typesize() in cc1 */
+static void
+memberdcl(int c)
+{
+	Symbol *sym;
+	Type *ap, *tp;
+	unsigned off, align;
+
+	if (!curaggr)
+		error(ESYNTAX);
+	ap = &curaggr->u.v.type;
+	sym = fieldsym(readnum(10));
+	tp = gettype(readc());
+	xfree(readname());
+
+	if (ap->letter == L_UNION) {
+		off = 0;
+		if (tp->size > ap->size)
+			ap->size = tp->size;
+	} else {
+		align = tp->align - 1;
+		off = ap->size + align & ~align;
+		ap->size = off + tp->size;
+	}
+	if (tp->align > ap->align)
+		ap->align = tp->align;
+	sym->u.v.off = off;
+}
+
+/* the parameters are declared between { and \ */
+static void
+beginfun(int c)
+{
+	if (curfun || !lastfun)
+		error(ESYNTAX);
+	curfun = newfun(lastfun);
+	lastfun = NULL;
+	inpars = 1;
+}
+
+static void
+endpars(int c)
+{
+	if (!inpars)
+		error(ESYNTAX);
+	inpars = 0;
+}
+
+/* the types of the functions are not needed, F id ret pars... */
+static void
+functype(int c)
+{
+	readnum(10);
+	while ((c = readc()) != '\n') {
+		switch (c) {
+		case L_FUNCTION:
+		case L_ARRAY:
+		case L_STRUCT:
+		case L_UNION:
+			readnum(10);
+		}
+	}
+}
+
+static void (*rectbl[])(int) = {
+	['L'] = labeldcl,
+	['\t'] = expression,
+	['{'] = beginfun,
+	['\\'] = endpars,
+	['F'] = functype,
+	['V'] = arraydcl,
+	['S'] = aggrdcl,
+	['U'] = aggrdcl,
+	['M'] = memberdcl,
+	['A'] = localdcl,
+	['R'] = localdcl,
+	['T'] = localdcl,
+	['Y'] = globdcl,
+	['G'] = globdcl,
+	['X'] = globdcl,
+	['\177'] = NULL
+};
+
+Func *
 parse(void)
 {
-	void (*fun)(char *tok);
-	uint8_t len;
+	void (*fun)(int c);
 	int c;
-	char line[MAXLINE];
 
 	curfun = NULL;
-	stackp = stack;
-	listp = listexp;
-	newp = nodepool;
+	inpars = 0;
+	nstack = 0;
 
 	for (;;) {
-		switch (c = getchar()) {
-		case 'L':
-			fun = deflabel;
-			break;
-		case '\t':
-			fun = expression;
-			break;
-		case 'S':
-			/* TODO: struct */
-			break;
-		case 'P':
-			fun = paramdcl;
-			break;
-		case 'A': case 'R': case 'T':
-			fun = localdcl;
-			break;
-		case 'Y': case 'G':
-			fun = globdcl;
-			break;
+		switch (c = getbyte()) {
+		case IR_MAGIC:
+			binary = 1;
+			continue;
+		case '\n':
+			continue;
 		case '}':
-			if (curfun)
-				return;
-		default:
+			if (curfun && !inpars) {
+				addstmt(curfun, NULL);
+				return curfun;
+			}
+			goto syntax_error;
+		case EOF:
+			/* declarations after the last function */
+			if (!curfun)
+				return NULL;
 			goto syntax_error;
 		}
-
-		ungetc(c, stdin);
-		if (!fgets(line, sizeof(line), stdin))
-			break;
-		len = strlen(line);
-		if (line[len-1] != '\n')
-			error(ELNLINE);
-		line[len-1] = '\0';
-		(*fun)(strtok(line, "\t"));
+		if (c > 0x7f || (fun = rectbl[c]) == NULL)
+			goto syntax_error;
+		eol = 0;
+		(*fun)(c);
+		if (readc() != '\n')
+			goto syntax_error;
 	}
 
 syntax_error:
@@ -1,39 +1,535 @@
-
 #include <inttypes.h>
 #include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef PEEPSTATS
+#include <pthread.h>
+#endif
 
 #include "../inc/cc.h"
 #include "cc2.h"
 
+/*
+ * The peephole optimizer is a table of rules. Every rule matches a
+ * window of 1 to 4 instructions that ends in the current one, so
+ * the window is always before the gap of the program (see code.c),
+ * and the instructions of the window are consecutive. The opcodes
+ * of the window are checked with a mask for every position, and
+ * then the function of the rule checks the operands and builds the
+ * replacement. Only the first instruction of a window can have a
+ * label, unless the rule accepts a label in the last one.
+ *
+ * The replacement is put again before the gap, so the rules are
+ * tried again until none of them matches the current instruction,
+ * and the passes over the program are repeated until nothing
+ * changes. Every rule makes the code shorter or cheaper, so the
+ * loop finishes.
+ *
+ * The rules that change the flags are not applied when a flag that
+ * they change is live, because a conditional jump tests it or ADC,
+ * SBC or RR use the carry.
+ */
+#define MAXWIN 4
+#define M(op) (1UL << (op))
+#define ANY (~0UL)
+#define STORE (M(LDL) | M(LDH))
+
+#define FC 1
+#define FZ 2
+#define FS 4
+#define FP 8
+#define FALL (FC | FZ | FS | FP)
+
+struct jump {
+	unsigned id;
+	Symbol *label, *to;
+};
+
+struct peep {
+	Func *fn;
+	struct jump *jumps;         /* jumps with a label, sorted by id */
+	unsigned njumps;
+	unsigned long *hits;        /* times that every rule was applied */
+};
+
+struct rule {
+	char *name;
+	uint8_t len;                /* instructions in the window */
+	unsigned long ops[MAXWIN];  /* opcodes allowed in every position */
+	bool label;                 /* the last one can have a label */
+	uint8_t flags;              /* flags changed by the replacement */
+	int (*fun)(struct peep *, Inst *, int, Inst *);
+};
+
+static uint8_t halves[][2] = {
+	[HL] = {H, L}, [DE] = {D, E}, [BC] = {B, C}, [IY] = {IYH, IYL}
+};
+
+static bool
+overlap(uint8_t r, uint8_t s)
+{
+	if (r == s)
+		return 1;
+	if (r >= NREGS && r < NPAIRS && r != AF)
+		return halves[r][0] == s || halves[r][1] == s;
+	if (s >= NREGS && s < NPAIRS && s != AF)
+		return halves[s][0] == r || halves[s][1] == r;
+	return 0;
+}
+
+/* the operand reads the register */
+static bool
+reads(Addr *a, uint8_t reg)
+{
+	switch (a->kind) {
+	case REG:
+		return overlap(a->u.reg, reg);
+	case INDEX:
+		return overlap(HL, reg);
+	case INDEXY:
+		return overlap(IY, reg);
+	default:
+		return 0;
+	}
+}
+
+static bool
+isreg8(Addr *a)
+{
+	return a->kind == REG && a->u.reg >= A && a->u.reg <= L;
+}
+
+static bool
+sameaddr(Addr *a, Addr *b)
+{
+	if (a->kind != b->kind)
+		return 0;
+	switch (a->kind) {
+	case REG:
+		return a->u.reg == b->u.reg;
+	case CONST:
+	case AUTO:
+	case PAR:
+	case INDEXY:
+		return a->u.i == b->u.i;
+	case MEM:
+		return a->u.sym == b->u.sym && a->off == b->off;
+	case LABEL:
+		return a->u.sym == b->u.sym;
+	default:
+		return 1;
+	}
+}
+
+/* a store of a register in the stack frame or in a global */
+static bool
+isstore(Inst *pc)
+{
+	switch (pc->to.kind) {
+	case AUTO:
+	case PAR:
+	case MEM:
+		return pc->from.kind == REG;
+	default:
+		return 0;
+	}
+}
+
+/* the upper byte of LDH is in the next position of the frame */
+static bool
+alias(Inst *p1, Addr *a1, Inst *p2, Addr *a2)
+{
+	if (a1->kind == MEM || a2->kind == MEM) {
+		return a1->kind == a2->kind && a1->u.sym == a2->u.sym &&
+		       a1->off + (p1->op == LDH) == a2->off + (p2->op == LDH);
+	}
+	return a1->u.i + (p1->op == LDH) == a2->u.i + (p2->op == LDH);
+}
+
+/* LD r,r */
+static int
+ldself(struct peep *pp, Inst *w, int n, Inst *out)
+{
+	if (w[0].to.kind != REG || !sameaddr(&w[0].to, &w[0].from))
+		return -1;
+	return 0;
+}
+
+/* the instructions after a jump or a return without a label */
+static int
+unreach(struct peep *pp, Inst *w, int n, Inst *out)
+{
+	if (w[0].from.kind == COND)
+		return -1;
+	out[0] = w[0];
+	return 1;
+}
+
+/* JP L; L: */
+static int
+jpnext(struct peep *pp, Inst *w, int n, Inst *out)
+{
+	if (w[0].to.kind != LABEL || w[1].label != w[0].to.u.sym)
+		return -1;
+	out[0] = w[1];
+	return 1;
+}
+
+static int
+cmpjump(const void *p1, const void *p2)
+{
+	const struct jump *j1 = p1, *j2 = p2;
+
+	return (j1->id > j2->id) - (j1->id < j2->id);
+}
+
+static Symbol *
+jumpto(struct peep *pp, Symbol *sym)
+{
+	struct jump key, *jp;
+	Symbol *to = sym;
+	unsigned n;
+
+	for (n = 0; n <= pp->njumps; ++n) {
+		key.id = to->id;
+		jp = bsearch(&key, pp->jumps, pp->njumps, sizeof(*jp), cmpjump);
+		if (!jp)
+			return to;
+		if ((to = jp->to) == sym)
+			break;
+	}
+	/* the jumps make a loop */
+	return sym;
+}
+
+/* JP L1, when L1: JP L2 */
+static int
+thread(struct peep *pp, Inst *w, int n, Inst *out)
+{
+	Symbol *to;
+
+	if (w[0].to.kind != LABEL)
+		return -1;
+	if ((to = jumpto(pp, w[0].to.u.sym)) == w[0].to.u.sym)
+		return -1;
+	out[0] = w[0];
+	out[0].to.u.sym = to;
+	return 1;
+}
+
+/*
+ * LD (x),r; LD r',(x), with stores to other places between them.
+ * The value is still in r, so it is copied from there.
+ */
+static int
+reload(struct peep *pp, Inst *w, int n, Inst *out)
+{
+	Inst *st = &w[0], *ld = &w[n-1];
+	int i;
+
+	if (!isstore(st) || !isreg8(&st->from) || !isreg8(&ld->to))
+		return -1;
+	if (st->op != ld->op || st->to.kind != ld->from.kind)
+		return -1;
+	if (!alias(st, &st->to, ld, &ld->from))
+		return -1;
+	for (i = 1; i < n-1; ++i) {
+		if (!isstore(&w[i]) || alias(st, &st->to, &w[i], &w[i].to))
+			return -1;
+	}
+
+	for (i = 0; i < n-1; ++i)
+		out[i] = w[i];
+	if (ld->to.u.reg == st->from.u.reg)
+		return n-1;
+	out[i].op = MOV;
+	out[i].to = ld->to;
+	out[i].from = st->from;
+	out[i].label = NULL;
+	return n;
+}
+
+/* a register loaded again before being used */
+static int
+deadld(struct peep *pp, Inst *w, int n, Inst *out)
+{
+	uint8_t r;
+
+	if (w[0].to.kind != REG || w[1].to.kind != REG)
+		return -1;
+	if ((r = w[0].to.u.reg) >= NPAIRS)
+		return -1;
+	if (w[1].to.u.reg != r && !overlap(w[1].to.u.reg, r))
+		return -1;
+	if (w[1].to.u.reg < NREGS && r >= NREGS)
+		return -1;
+	if (reads(&w[1].from, r))
+		return -1;
+	out[0] = w[1];
+	return 1;
+}
+
+/* PUSH rr; POP rr' */
+static int
+pushpop(struct peep *pp, Inst *w, int n, Inst *out)
+{
+	uint8_t from = w[0].from.u.reg, to = w[1].to.u.reg;
+	int i;
+
+	if (from == to)
+		return 0;
+	if ((from != HL && from != DE && from != BC) ||
+	    (to != HL && to != DE && to != BC)) {
+		return -1;
+	}
+	for (i = 0; i < 2; ++i) {
+		out[i].op = MOV;
+		out[i].label = NULL;
+		out[i].to.kind = out[i].from.kind = REG;
+		out[i].to.u.reg = halves[to][i];
+		out[i].from.u.reg = halves[from][i];
+	}
+	return 2;
+}
+
+/* INC x; DEC x */
+static int
+incdec(struct peep *pp, Inst *w, int n, Inst *out)
+{
+	if (w[0].op == w[1].op || !sameaddr(&w[0].to, &w[1].to))
+		return -1;
+	return 0;
+}
+
+/* LD A,0 */
+static int
+clra(struct peep *pp, Inst *w, int n, Inst *out)
+{
+	if (w[0].to.kind != REG || w[0].to.u.reg != A ||
+	    w[0].from.kind != CONST || w[0].from.u.i != 0) {
+		return -1;
+	}
+	out[0] = w[0];
+	out[0].op = XOR;
+	out[0].from = w[0].to;
+	return 1;
+}
+
+/* ADD and SUB of small constants */
+static int
+addk(struct peep *pp, Inst *w, int n, Inst *out)
+{
+	TINT i, k;
+
+	if (w[0].from.kind != CONST)
+		return -1;
+	if ((k = w[0].from.u.i) < 0 || k >= 4)
+		return -1;
+	for (i = 0; i < k; ++i) {
+		out[i].op = (w[0].op == ADD) ? INC : DEC;
+		out[i].to = w[0].to;
+		out[i].from.kind = NONE;
+		out[i].label = NULL;
+	}
+	return k;
+}
+
+static struct rule rules[] = {
+	{"ld r,r", 1, {M(MOV) | M(LDL)}, 0, 0, ldself},
+	{"unreachable", 2, {M(JP) | M(RET), ANY}, 0, 0, unreach},
+	{"jump to next", 2, {M(JP), ANY}, 1, 0, jpnext},
+	{"jump to jump", 1, {M(JP)}, 0, 0, thread},
+	{"load after store", 2, {STORE, STORE}, 0, 0, reload},
+	{"load after 2 stores", 3, {STORE, STORE, STORE}, 0, 0, reload},
+	{"load after 3 stores", 4, {STORE, STORE, STORE, STORE}, 0, 0, reload},
+	{"dead load", 2,
+	 {M(LDL) | M(LDI) | M(MOV), M(LDL) | M(LDI) | M(MOV)}, 0, 0, deadld},
+	{"push pop", 2, {M(PUSH), M(POP)}, 0, 0, pushpop},
+	{"inc dec", 2, {M(INC) | M(DEC), M(INC) | M(DEC)}, 0, FZ|FS|FP, incdec},
+	{"ld a,0", 1, {M(LDI)}, 0, FALL, clra},
+	{"add small", 1, {M(ADD) | M(SUB)}, 0, FC, addk},
+};
+
+#define NR_RULES (sizeof(rules) / sizeof(rules[0]))
+
+#ifdef PEEPSTATS
+static pthread_mutex_t statlock = PTHREAD_MUTEX_INITIALIZER;
+static unsigned long nhits[NR_RULES];
+
+void
+peepstats(void)
+{
+	unsigned i;
+
+	fprintf(stderr, "%-20s %10s\n", "peephole", "hits");
+	for (i = 0; i < NR_RULES; ++i)
+		fprintf(stderr, "%-20s %10lu\n", rules[i].name, nhits[i]);
+}
+
+static void
+addstats(struct peep *pp)
+{
+	unsigned i;
+
+	pthread_mutex_lock(&statlock);
+	for (i = 0; i < NR_RULES; ++i)
+		nhits[i] += pp->hits[i];
+	pthread_mutex_unlock(&statlock);
+}
+#else
 void
-peephole(void)
+peepstats(void)
+{
+}
+
+static void
+addstats(struct peep *pp)
 {
-	Addr to, from;
-	TINT i;
-	uint8_t op;
+}
+#endif
 
-	for (pc = prog; pc; pc = pc->next) {
-		to = pc->to;
-		from = pc->from;
+/* the labels of jumps, which must be found with the gap at the end */
+static void
+findjumps(struct peep *pp)
+{
+	Func *fn = pp->fn;
+	Inst *pc, *end = &fn->prog[fn->ninst];
+	struct jump *jp;
 
+	pp->njumps = 0;
+	for (pc = fn->prog; pc < end; ++pc) {
+		if (!pc->label || pc->op != JP || pc->to.kind != LABEL)
+			continue;
+		if (pc->from.kind == COND)
+			continue;
+		pp->jumps = xrealloc(pp->jumps,
+		                     (pp->njumps+1) * sizeof(*pp->jumps));
+		jp = &pp->jumps[pp->njumps++];
+		jp->id = pc->label->id;
+		jp->label = pc->label;
+		jp->to = pc->to.u.sym;
+	}
+	qsort(pp->jumps, pp->njumps, sizeof(*pp->jumps), cmpjump);
+}
+
+static uint8_t condflag[] = {
+	[CCNZ] = FZ, [CCZ] = FZ, [CCNC] = FC, [CCC] = FC,
+	[CCPO] = FP, [CCPE] = FP, [CCP] = FS, [CCM] = FS
+};
+
+/*
+ * Some of the flags after the current instruction are used before
+ * another instruction sets them. The flags are never live after a
+ * call, a return or a jump that is always taken, but they can be
+ * live after a label, as in the sign fixed in fixsign() of isel.c.
+ */
+static bool
+flagslive(Func *fn, uint8_t flags)
+{
+	Inst *pc, *end = &fn->prog[fn->maxinst];
+
+	for (pc = &fn->prog[fn->tail]; pc < end; ++pc) {
 		switch (pc->op) {
-		case SUB:
-		case ADD:
-			if (from.kind == CONST) {
-				if ((i = from.u.i) == 0 || i < 4) {
-					delcode();
-					op = (pc->op == ADD) ? INC : DEC;
-
-					while (i--)
-						inscode(op, &to, NULL);
-				}
-			/* TODO: More optimizations (ex: -1) */
-			}
-			break;
 		case JP:
-			if (to.u.sym->u.pc == pc->next)
-				delcode();
+			if (pc->from.kind != COND)
+				return 0;
+			if (condflag[pc->from.u.i] & flags)
+				return 1;
 			break;
+		case ADC:
+		case SBC:
+		case RR:
+			return (flags & FC) != 0;
+		case ADD:
+			if (pc->to.u.reg >= NREGS)
+				break;
+			/* PASSTROUGH */
+		case SUB:
+		case AND:
+		case OR:
+		case XOR:
+		case NEG:
+		case CP:
+		case SRA:
+		case SRL:
+		case CALL:
+		case RET:
+			return 0;
 		}
 	}
+	return 0;
+}
+
+static bool
+match(struct rule *rp, Inst *w)
+{
+	int i, last = rp->len - 1;
+
+	for (i = 0; i <= last; ++i) {
+		if ((rp->ops[i] & M(w[i].op)) == 0)
+			return 0;
+		if (i > 0 && w[i].label && (i < last || !rp->label))
+			return 0;
+	}
+	return 1;
+}
+
+/* apply the first rule that matches the current instruction */
+static bool
+rewrite(struct peep *pp)
+{
+	Func *fn = pp->fn;
+	struct rule *rp;
+	Inst out[MAXWIN], *w, *pc;
+	Symbol *label;
+	int i, n;
+
+	for (rp = rules; rp < &rules[NR_RULES]; ++rp) {
+		if (rp->len > fn->ninst)
+			continue;
+		pc = &fn->prog[fn->ninst-1];
+		if ((rp->ops[rp->len-1] & M(pc->op)) == 0)
+			continue;
+		w = pc - (rp->len-1);
+		if (!match(rp, w) || rp->flags && flagslive(fn, rp->flags))
+			continue;
+		if ((n = (*rp->fun)(pp, w, rp->len, out)) < 0)
+			continue;
+
+		/* the label of the window goes to the replacement */
+		if ((label = w[0].label) != NULL) {
+			if (n == 0 || (out[0].label && out[0].label != label))
+				continue;
+			out[0].label = label;
+		}
+		fn->ninst -= rp->len;
+		for (i = 0; i < n; ++i) {
+			inscode(fn, out[i].op, &out[i].to, &out[i].from);
+			fn->prog[fn->ninst-1].label = out[i].label;
+		}
+		++pp->hits[rp - rules];
+		return 1;
+	}
+	return 0;
+}
+
+void
+peephole(Func *fn)
+{
+	unsigned long hits[NR_RULES] = {0};
+	struct peep peep = {.fn = fn, .hits = hits}, *pp = &peep;
+	bool changed;
+
+	do {
+		changed = 0;
+		findjumps(pp);
+		startcode(fn);
+		while (nextcode(fn) != NULL) {
+			while (rewrite(pp))
+				changed = 1;
+		}
+	} while (changed);
+
+	addstats(pp);
+	xfree(pp->jumps);
 }
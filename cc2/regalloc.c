@@ -0,0 +1,314 @@
+
+#include <inttypes.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../inc/cc.h"
+#include "cc2.h"
+
+#define MAXDEPTH 4
+
+/*
+ * The local variables are kept in registers during all the
+ * function when it is possible. The live range of a variable is
+ * approximated by the statements between its first and its last
+ * use, extended to the blocks where it is live at the entry or at
+ * the exit, because the value must survive the jumps. The ranges
+ * are assigned with a linear scan, and when there is no free
+ * register the variable with the lowest weight stays in its slot
+ * of the stack frame. The weight is the number of uses, multiplied
+ * by 8 for every loop around them.
+ *
+ * A is the accumulator and HL is used to index memory, so the
+ * variables of 8 bits use B, C, D and E, and the variables of 16
+ * bits use BC and DE. IY is not used, because it cannot be moved
+ * to the other pairs with a single instruction. DE is not used in
+ * the functions with operations of 32 bits, which can keep a value
+ * in DE:HL.
+ */
+struct live {
+	Symbol *sym;
+	unsigned first, last;       /* statements where it is used */
+	unsigned weight;
+	uint8_t size;
+	bool addressed;
+	uint8_t reg;
+};
+
+struct ralloc {
+	Func *fn;
+	struct live *lives;
+	unsigned nlives, maxlives;
+	unsigned *depth;
+	struct live *owner[NREGS];
+	struct live dehl;           /* owner of D and E, see uses() */
+};
+
+static uint8_t reg8[] = {C, E, B, D, 0};
+static uint8_t reg16[] = {BC, DE, 0};
+static uint8_t upper[] = {[BC] = B, [DE] = D};
+static uint8_t lower[] = {[BC] = C, [DE] = E};
+static uint8_t mate[] = {[B] = C, [C] = B, [D] = E, [E] = D};
+
+static struct live *
+getlive(struct ralloc *ra, Symbol *sym)
+{
+	struct live *lp;
+
+	for (lp = ra->lives; lp < &ra->lives[ra->nlives]; ++lp) {
+		if (lp->sym == sym)
+			return lp;
+	}
+	if (ra->nlives == ra->maxlives) {
+		ra->maxlives = (ra->maxlives) ? 2*ra->maxlives : 16;
+		ra->lives = xrealloc(ra->lives,
+		                     ra->maxlives * sizeof(*ra->lives));
+	}
+	lp = &ra->lives[ra->nlives++];
+	lp->sym = sym;
+	lp->first = UINT_MAX;
+	lp->last = 0;
+	lp->weight = 0;
+	lp->size = 0;
+	lp->addressed = 0;
+	lp->reg = 0;
+	return lp;
+}
+
+static void
+uses(struct ralloc *ra, Node *np, unsigned stmt)
+{
+	struct live *lp;
+	unsigned d;
+
+	if (!np)
+		return;
+	if (np->op == OADDR && np->left->op == AUTO)
+		getlive(ra, np->left->sym)->addressed = 1;
+	if (np->type.size == 4 && np->op != AUTO && np->op != PAR &&
+	    np->op != MEM && np->op != CONST) {
+		ra->owner[D] = ra->owner[E] = &ra->dehl;
+	}
+	if (np->op == AUTO && np->sym) {
+		lp = getlive(ra, np->sym);
+		if (lp->first > stmt)
+			lp->first = stmt;
+		if (lp->last < stmt)
+			lp->last = stmt;
+		if ((d = ra->depth[stmt]) > MAXDEPTH)
+			d = MAXDEPTH;
+		lp->weight += 1 << 3*d;
+		lp->size = np->sym->u.v.type.size;
+	}
+	uses(ra, np->left, stmt);
+	uses(ra, np->right, stmt);
+}
+
+/*
+ * Every jump to a previous statement closes a loop, and the depth
+ * of a statement is the number of loops around it
+ */
+static void
+loops(struct ralloc *ra)
+{
+	Func *fn = ra->fn;
+	Block *bp, *to, *end = &fn->blocks[fn->nblocks];
+	unsigned i, n = fn->nstmts;
+	int *delta, d;
+
+	delta = xcalloc(n + 1, sizeof(*delta));
+	for (bp = fn->blocks; bp < end; ++bp) {
+		for (i = 0; i < bp->nsuccs; ++i) {
+			to = bp->succs[i];
+			if (to->begin > bp->begin)
+				continue;
+			++delta[to->begin];
+			--delta[bp->end];
+		}
+	}
+	for (d = i = 0; i < n; ++i) {
+		d += delta[i];
+		ra->depth[i] = d;
+	}
+	xfree(delta);
+}
+
+static void
+extend(struct ralloc *ra, struct live *lp)
+{
+	Func *fn = ra->fn;
+	Block *bp, *end = &fn->blocks[fn->nblocks];
+	int idx;
+
+	if ((idx = varidx(fn, lp->sym)) < 0)
+		return;
+	for (bp = fn->blocks; bp < end; ++bp) {
+		if (bp->rpo == UINT_MAX)
+			continue;
+		if (islive(bp->in, idx) && lp->first > bp->begin)
+			lp->first = bp->begin;
+		if (islive(bp->out, idx) && lp->last < bp->end-1)
+			lp->last = bp->end-1;
+	}
+}
+
+static int
+cmplive(const void *p1, const void *p2)
+{
+	const struct live *l1 = p1, *l2 = p2;
+
+	return (l1->first > l2->first) - (l1->first < l2->first);
+}
+
+static void
+take(struct ralloc *ra, struct live *lp, uint8_t reg)
+{
+	lp->reg = reg;
+	if (reg >= NREGS)
+		ra->owner[upper[reg]] = ra->owner[lower[reg]] = lp;
+	else
+		ra->owner[reg] = lp;
+}
+
+static void
+release(struct ralloc *ra, struct live *lp)
+{
+	uint8_t r;
+
+	for (r = 0; r < NREGS; ++r) {
+		if (ra->owner[r] == lp)
+			ra->owner[r] = NULL;
+	}
+}
+
+static uint8_t
+freereg(struct ralloc *ra, unsigned size)
+{
+	uint8_t *bp, r, found = 0;
+
+	if (size == 2) {
+		for (bp = reg16; r = *bp; ++bp) {
+			if (!ra->owner[upper[r]] && !ra->owner[lower[r]])
+				return r;
+		}
+		return 0;
+	}
+	/* use the half of a pair that is already taken if possible */
+	for (bp = reg8; r = *bp; ++bp) {
+		if (ra->owner[r])
+			continue;
+		if (ra->owner[mate[r]])
+			return r;
+		if (!found)
+			found = r;
+	}
+	return found;
+}
+
+/*
+ * When there is no free register, the variable with the lowest
+ * weight that frees a register of the needed size is spilled
+ */
+static struct live *
+victim(struct ralloc *ra, struct live *cur)
+{
+	struct live *lp, *best = NULL;
+	uint8_t *bp, r;
+
+	for (bp = reg8; r = *bp; ++bp) {
+		if ((lp = ra->owner[r]) == NULL)
+			continue;
+		if (cur->size == 2 && lp->size == 1 && ra->owner[mate[r]])
+			continue;
+		if (!best || lp->weight < best->weight)
+			best = lp;
+	}
+	return (best && best->weight < cur->weight) ? best : NULL;
+}
+
+static void
+scan(struct ralloc *ra)
+{
+	struct live *lp, *v, *end = &ra->lives[ra->nlives];
+	uint8_t r;
+
+	qsort(ra->lives, ra->nlives, sizeof(*ra->lives), cmplive);
+	for (lp = ra->lives; lp < end; ++lp) {
+		if (lp->addressed || lp->size == 0 || lp->size > 2)
+			continue;
+		for (r = 0; r < NREGS; ++r) {
+			if ((v = ra->owner[r]) != NULL && v->last < lp->first)
+				release(ra, v);
+		}
+		if ((r = freereg(ra, lp->size)) == 0) {
+			if ((v = victim(ra, lp)) == NULL)
+				continue;
+			release(ra, v);
+			v->reg = 0;
+			r = freereg(ra, lp->size);
+		}
+		take(ra, lp, r);
+	}
+}
+
+static void
+rewrite(struct ralloc *ra, Node *np)
+{
+	struct live *lp;
+
+	if (!np)
+		return;
+	if (np->op == AUTO && np->sym) {
+		lp = getlive(ra, np->sym);
+		if (lp->reg) {
+			np->op = REG;
+			np->reg = lp->reg;
+		}
+	}
+	rewrite(ra, np->left);
+	rewrite(ra, np->right);
+}
+
+void
+regalloc(Func *fn)
+{
+	struct ralloc ra;
+	struct live *lp;
+	struct regvar *rp;
+	Node **stmt;
+	unsigned i, n = 0;
+
+	memset(&ra, 0, sizeof(ra));
+	ra.fn = fn;
+	ra.dehl.last = ra.dehl.weight = UINT_MAX;
+	ra.depth = xcalloc(fn->nstmts + 1, sizeof(*ra.depth));
+	loops(&ra);
+	for (i = 0, stmt = fn->body; *stmt; ++stmt, ++i)
+		uses(&ra, *stmt, i);
+	for (lp = ra.lives; lp < &ra.lives[ra.nlives]; ++lp)
+		extend(&ra, lp);
+	scan(&ra);
+
+	for (lp = ra.lives; lp < &ra.lives[ra.nlives]; ++lp) {
+		if (lp->reg)
+			++n;
+	}
+	if (n > 0) {
+		fn->regvars = rp = xmalloc(n * sizeof(*rp));
+		fn->nregvars = n;
+		for (lp = ra.lives; lp < &ra.lives[ra.nlives]; ++lp) {
+			if (!lp->reg)
+				continue;
+			rp->sym = lp->sym;
+			rp->reg = lp->reg;
+			++rp;
+			fn->varregs[lp->reg] = 1;
+		}
+		for (stmt = fn->body; *stmt; ++stmt)
+			rewrite(&ra, *stmt);
+	}
+
+	xfree(ra.lives);
+	xfree(ra.depth);
+}
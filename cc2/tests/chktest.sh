@@ -0,0 +1,37 @@
+#!/bin/sh
+
+out=/tmp/$$.out
+err=/tmp/$$.err
+tst=/tmp/$$.tst
+
+trap "rm -f $out $err $tst" EXIT INT QUIT HUP
+rm -f test.log
+
+# the IR is taken from the .ir files or from the output of cc1
+for i
+do
+	printf "Running %s " $i
+	case $i in
+	*.ir)
+		../cc2 < $i > $out 2>$err
+		# the errors of the encoder are only seen with -c
+		../cc2 -c < $i 2>>$err >/dev/null
+		;;
+	*.c)
+		# the binary form and scc must give the same code
+		../../cc1/cc1 -w $i | ../cc2 > $out 2>$err
+		../../cc1/cc1 -w -Fbin $i | ../cc2 2>&1 | cmp -s - $out ||
+			echo binary form differs >> $err
+		../../driver/scc -w $i 2>&1 | cmp -s - $out ||
+			echo scc differs >> $err
+		;;
+	esac
+	echo $i >> test.log
+	cat $err $out > $tst
+	if diff -c ${i%.*}.s $tst >> test.log
+	then
+		echo [OK]
+	else
+		echo [FAILED]
+	fi
+done
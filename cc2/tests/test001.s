@@ -0,0 +1,78 @@
+f:
+	PUSH	IX
+	LD	IX,SP
+	LD	HL,-8
+	ADD	HL,SP
+	LD	SP,HL
+	LD	HL,5
+	LD	A,L
+	ADD	A,(IX-4)
+	LD	L,A
+	LD	A,H
+	ADC	A,(IX-3)
+	LD	H,A
+	LD	C,L
+	LD	B,H
+	OR	A,A
+	SBC	HL,DE
+	LD	(IX-4),L
+	LD	(IX-3),H
+	LD	A,L
+	AND	A,C
+	LD	L,A
+	LD	A,H
+	AND	A,B
+	LD	H,A
+	LD	E,L
+	LD	D,H
+	LD	A,L
+	XOR	A,C
+	LD	L,A
+	LD	A,H
+	XOR	A,B
+	LD	H,A
+	LD	E,L
+	LD	D,H
+	LD	HL,3
+	ADD	HL,BC
+	LD	C,L
+	LD	B,H
+	LD	(IX-8),C
+	LD	A,C
+	LD	L,A
+	ADD	A,A
+	SBC	A,A
+	LD	H,A
+	LD	C,L
+	LD	B,H
+	LD	(gi),HL
+	INC	HL
+	LD	C,L
+	LD	B,H
+	LD	L,(IX-4)
+	LD	H,(IX-3)
+	XOR	A,A
+	SUB	A,L
+	LD	L,A
+	SBC	A,A
+	SUB	A,H
+	LD	H,A
+	LD	(IX-4),L
+	LD	(IX-3),H
+	LD	L,E
+	LD	H,D
+	LD	A,L
+	CPL	A
+	LD	L,A
+	LD	A,H
+	CPL	A
+	LD	H,A
+	LD	E,L
+	LD	D,H
+	LD	L,(IX-4)
+	LD	H,(IX-3)
+	ADD	HL,BC
+	ADD	HL,DE
+L1000:	LD	SP,IX
+	POP	IX
+	RET
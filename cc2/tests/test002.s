@@ -0,0 +1,41 @@
+f:
+	PUSH	IX
+	LD	IX,SP
+	LD	HL,-12
+	ADD	HL,SP
+	LD	SP,HL
+	LD	A,(g)
+	LD	C,A
+	LD	A,(g)
+	INC	A
+	LD	B,A
+	LD	A,(g)
+	INC	A
+	INC	A
+	LD	(IX-6),A
+	LD	A,(g)
+	INC	A
+	INC	A
+	INC	A
+	LD	(IX-8),A
+	LD	A,(g)
+	ADD	A,4
+	LD	E,A
+	LD	A,C
+	LD	(g),A
+	LD	A,C
+	ADD	A,B
+	ADD	A,(IX-6)
+	ADD	A,(IX-8)
+	ADD	A,E
+	LD	D,A
+	LD	(g),A
+	LD	A,D
+	INC	A
+	LD	C,A
+	ADD	A,E
+	LD	(g),A
+L8:	LD	A,B
+L1000:	LD	SP,IX
+	POP	IX
+	RET
@@ -0,0 +1,24 @@
+f:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	L,E
+	LD	H,D
+	LD	C,(HL)
+	LD	L,E
+	LD	H,D
+	LD	(HL),C
+	LD	HL,3
+	ADD	HL,DE
+	LD	(HL),C
+	LD	HL,(gp)
+	LD	A,(HL)
+	ADD	A,C
+	LD	C,A
+	LD	IY,(gp)
+	LD	(IY+2),7
+	LD	A,C
+L1000:	LD	SP,IX
+	POP	IX
+	RET
@@ -0,0 +1,54 @@
+f:
+	PUSH	IX
+	LD	IX,SP
+	LD	HL,-12
+	ADD	HL,SP
+	LD	SP,HL
+	LD	A,(IX-8)
+	ADD	A,(IX-12)
+	LD	(IX-4),A
+	LD	A,(IX-7)
+	ADC	A,(IX-11)
+	LD	(IX-3),A
+	LD	A,(IX-6)
+	ADC	A,(IX-10)
+	LD	(IX-2),A
+	LD	A,(IX-5)
+	ADC	A,(IX-9)
+	LD	(IX-1),A
+	LD	A,(IX-4)
+	SUB	A,0
+	LD	(IX-4),A
+	LD	A,(IX-3)
+	SBC	A,0
+	LD	(IX-3),A
+	LD	A,(IX-2)
+	SBC	A,1
+	LD	(IX-2),A
+	LD	A,(IX-1)
+	SBC	A,0
+	LD	(IX-1),A
+	LD	(IX-12),120
+	LD	(IX-11),86
+	LD	(IX-10),52
+	LD	(IX-9),18
+	LD	A,(IX-4)
+	ADD	A,1
+	LD	(IX-4),A
+	LD	A,(IX-3)
+	ADC	A,0
+	LD	(IX-3),A
+	LD	A,(IX-2)
+	ADC	A,0
+	LD	(IX-2),A
+	LD	A,(IX-1)
+	ADC	A,0
+	LD	(IX-1),A
+	LD	E,(IX-12)
+	LD	D,(IX-11)
+	LD	L,(IX-4)
+	LD	H,(IX-3)
+	ADD	HL,DE
+L1000:	LD	SP,IX
+	POP	IX
+	RET
@@ -0,0 +1,9 @@
+f:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	LD	A,(g)
+	LD	C,A
+L1000:	LD	SP,IX
+	POP	IX
+	RET
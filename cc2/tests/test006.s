@@ -0,0 +1,15 @@
+f:
+	PUSH	IX
+	LD	IX,SP
+	LD	HL,-10
+	ADD	HL,SP
+	LD	SP,HL
+	LD	C,0
+L7:	LD	A,B
+	ADD	A,C
+	LD	B,A
+	INC	C
+	JP	L7
+L1000:	LD	SP,IX
+	POP	IX
+	RET
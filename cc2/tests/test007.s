@@ -0,0 +1,38 @@
+main:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	HL,31
+	ADD	HL,DE
+	LD	C,L
+	LD	B,H
+	LD	HL,3
+	ADD	HL,BC
+	LD	C,L
+	LD	B,H
+	ADD	HL,DE
+	JP	L1000
+L4:	NOP
+L1000:	LD	SP,IX
+	POP	IX
+	RET
+foo:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	HL,31
+	ADD	HL,DE
+	LD	C,L
+	LD	B,H
+	LD	HL,3
+	ADD	HL,BC
+	LD	C,L
+	LD	B,H
+	ADD	HL,DE
+	JP	L1001
+L4:	NOP
+L1001:	LD	SP,IX
+	POP	IX
+	RET
@@ -0,0 +1,3480 @@
+f0:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1000:	LD	SP,IX
+	POP	IX
+	RET
+f1:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1001:	LD	SP,IX
+	POP	IX
+	RET
+f2:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1002:	LD	SP,IX
+	POP	IX
+	RET
+f3:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1003:	LD	SP,IX
+	POP	IX
+	RET
+f4:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1004:	LD	SP,IX
+	POP	IX
+	RET
+f5:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1005:	LD	SP,IX
+	POP	IX
+	RET
+f6:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1006:	LD	SP,IX
+	POP	IX
+	RET
+f7:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1007:	LD	SP,IX
+	POP	IX
+	RET
+f8:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1008:	LD	SP,IX
+	POP	IX
+	RET
+f9:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1009:	LD	SP,IX
+	POP	IX
+	RET
+f10:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1010:	LD	SP,IX
+	POP	IX
+	RET
+f11:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1011:	LD	SP,IX
+	POP	IX
+	RET
+f12:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1012:	LD	SP,IX
+	POP	IX
+	RET
+f13:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1013:	LD	SP,IX
+	POP	IX
+	RET
+f14:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1014:	LD	SP,IX
+	POP	IX
+	RET
+f15:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1015:	LD	SP,IX
+	POP	IX
+	RET
+f16:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1016:	LD	SP,IX
+	POP	IX
+	RET
+f17:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1017:	LD	SP,IX
+	POP	IX
+	RET
+f18:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1018:	LD	SP,IX
+	POP	IX
+	RET
+f19:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1019:	LD	SP,IX
+	POP	IX
+	RET
+f20:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1020:	LD	SP,IX
+	POP	IX
+	RET
+f21:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1021:	LD	SP,IX
+	POP	IX
+	RET
+f22:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1022:	LD	SP,IX
+	POP	IX
+	RET
+f23:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1023:	LD	SP,IX
+	POP	IX
+	RET
+f24:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1024:	LD	SP,IX
+	POP	IX
+	RET
+f25:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1025:	LD	SP,IX
+	POP	IX
+	RET
+f26:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1026:	LD	SP,IX
+	POP	IX
+	RET
+f27:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1027:	LD	SP,IX
+	POP	IX
+	RET
+f28:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1028:	LD	SP,IX
+	POP	IX
+	RET
+f29:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1029:	LD	SP,IX
+	POP	IX
+	RET
+f30:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1030:	LD	SP,IX
+	POP	IX
+	RET
+f31:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1031:	LD	SP,IX
+	POP	IX
+	RET
+f32:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1032:	LD	SP,IX
+	POP	IX
+	RET
+f33:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1033:	LD	SP,IX
+	POP	IX
+	RET
+f34:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1034:	LD	SP,IX
+	POP	IX
+	RET
+f35:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1035:	LD	SP,IX
+	POP	IX
+	RET
+f36:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1036:	LD	SP,IX
+	POP	IX
+	RET
+f37:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1037:	LD	SP,IX
+	POP	IX
+	RET
+f38:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1038:	LD	SP,IX
+	POP	IX
+	RET
+f39:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1039:	LD	SP,IX
+	POP	IX
+	RET
+f40:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1040:	LD	SP,IX
+	POP	IX
+	RET
+f41:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1041:	LD	SP,IX
+	POP	IX
+	RET
+f42:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1042:	LD	SP,IX
+	POP	IX
+	RET
+f43:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1043:	LD	SP,IX
+	POP	IX
+	RET
+f44:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1044:	LD	SP,IX
+	POP	IX
+	RET
+f45:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1045:	LD	SP,IX
+	POP	IX
+	RET
+f46:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1046:	LD	SP,IX
+	POP	IX
+	RET
+f47:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1047:	LD	SP,IX
+	POP	IX
+	RET
+f48:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1048:	LD	SP,IX
+	POP	IX
+	RET
+f49:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1049:	LD	SP,IX
+	POP	IX
+	RET
+f50:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1050:	LD	SP,IX
+	POP	IX
+	RET
+f51:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1051:	LD	SP,IX
+	POP	IX
+	RET
+f52:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1052:	LD	SP,IX
+	POP	IX
+	RET
+f53:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1053:	LD	SP,IX
+	POP	IX
+	RET
+f54:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1054:	LD	SP,IX
+	POP	IX
+	RET
+f55:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1055:	LD	SP,IX
+	POP	IX
+	RET
+f56:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1056:	LD	SP,IX
+	POP	IX
+	RET
+f57:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1057:	LD	SP,IX
+	POP	IX
+	RET
+f58:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1058:	LD	SP,IX
+	POP	IX
+	RET
+f59:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1059:	LD	SP,IX
+	POP	IX
+	RET
+f60:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1060:	LD	SP,IX
+	POP	IX
+	RET
+f61:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1061:	LD	SP,IX
+	POP	IX
+	RET
+f62:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1062:	LD	SP,IX
+	POP	IX
+	RET
+f63:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1063:	LD	SP,IX
+	POP	IX
+	RET
+f64:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1064:	LD	SP,IX
+	POP	IX
+	RET
+f65:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1065:	LD	SP,IX
+	POP	IX
+	RET
+f66:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1066:	LD	SP,IX
+	POP	IX
+	RET
+f67:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1067:	LD	SP,IX
+	POP	IX
+	RET
+f68:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1068:	LD	SP,IX
+	POP	IX
+	RET
+f69:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1069:	LD	SP,IX
+	POP	IX
+	RET
+f70:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1070:	LD	SP,IX
+	POP	IX
+	RET
+f71:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1071:	LD	SP,IX
+	POP	IX
+	RET
+f72:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1072:	LD	SP,IX
+	POP	IX
+	RET
+f73:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1073:	LD	SP,IX
+	POP	IX
+	RET
+f74:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1074:	LD	SP,IX
+	POP	IX
+	RET
+f75:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1075:	LD	SP,IX
+	POP	IX
+	RET
+f76:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1076:	LD	SP,IX
+	POP	IX
+	RET
+f77:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1077:	LD	SP,IX
+	POP	IX
+	RET
+f78:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1078:	LD	SP,IX
+	POP	IX
+	RET
+f79:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1079:	LD	SP,IX
+	POP	IX
+	RET
+f80:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1080:	LD	SP,IX
+	POP	IX
+	RET
+f81:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1081:	LD	SP,IX
+	POP	IX
+	RET
+f82:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1082:	LD	SP,IX
+	POP	IX
+	RET
+f83:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1083:	LD	SP,IX
+	POP	IX
+	RET
+f84:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1084:	LD	SP,IX
+	POP	IX
+	RET
+f85:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1085:	LD	SP,IX
+	POP	IX
+	RET
+f86:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1086:	LD	SP,IX
+	POP	IX
+	RET
+f87:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1087:	LD	SP,IX
+	POP	IX
+	RET
+f88:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1088:	LD	SP,IX
+	POP	IX
+	RET
+f89:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1089:	LD	SP,IX
+	POP	IX
+	RET
+f90:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1090:	LD	SP,IX
+	POP	IX
+	RET
+f91:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1091:	LD	SP,IX
+	POP	IX
+	RET
+f92:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1092:	LD	SP,IX
+	POP	IX
+	RET
+f93:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1093:	LD	SP,IX
+	POP	IX
+	RET
+f94:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1094:	LD	SP,IX
+	POP	IX
+	RET
+f95:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1095:	LD	SP,IX
+	POP	IX
+	RET
+f96:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1096:	LD	SP,IX
+	POP	IX
+	RET
+f97:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1097:	LD	SP,IX
+	POP	IX
+	RET
+f98:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1098:	LD	SP,IX
+	POP	IX
+	RET
+f99:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1099:	LD	SP,IX
+	POP	IX
+	RET
+f100:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1100:	LD	SP,IX
+	POP	IX
+	RET
+f101:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1101:	LD	SP,IX
+	POP	IX
+	RET
+f102:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1102:	LD	SP,IX
+	POP	IX
+	RET
+f103:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1103:	LD	SP,IX
+	POP	IX
+	RET
+f104:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1104:	LD	SP,IX
+	POP	IX
+	RET
+f105:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1105:	LD	SP,IX
+	POP	IX
+	RET
+f106:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1106:	LD	SP,IX
+	POP	IX
+	RET
+f107:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1107:	LD	SP,IX
+	POP	IX
+	RET
+f108:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1108:	LD	SP,IX
+	POP	IX
+	RET
+f109:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1109:	LD	SP,IX
+	POP	IX
+	RET
+f110:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1110:	LD	SP,IX
+	POP	IX
+	RET
+f111:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1111:	LD	SP,IX
+	POP	IX
+	RET
+f112:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1112:	LD	SP,IX
+	POP	IX
+	RET
+f113:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1113:	LD	SP,IX
+	POP	IX
+	RET
+f114:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1114:	LD	SP,IX
+	POP	IX
+	RET
+f115:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1115:	LD	SP,IX
+	POP	IX
+	RET
+f116:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1116:	LD	SP,IX
+	POP	IX
+	RET
+f117:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1117:	LD	SP,IX
+	POP	IX
+	RET
+f118:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1118:	LD	SP,IX
+	POP	IX
+	RET
+f119:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1119:	LD	SP,IX
+	POP	IX
+	RET
+f120:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1120:	LD	SP,IX
+	POP	IX
+	RET
+f121:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1121:	LD	SP,IX
+	POP	IX
+	RET
+f122:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1122:	LD	SP,IX
+	POP	IX
+	RET
+f123:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1123:	LD	SP,IX
+	POP	IX
+	RET
+f124:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1124:	LD	SP,IX
+	POP	IX
+	RET
+f125:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1125:	LD	SP,IX
+	POP	IX
+	RET
+f126:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1126:	LD	SP,IX
+	POP	IX
+	RET
+f127:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1127:	LD	SP,IX
+	POP	IX
+	RET
+f128:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1128:	LD	SP,IX
+	POP	IX
+	RET
+f129:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1129:	LD	SP,IX
+	POP	IX
+	RET
+f130:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1130:	LD	SP,IX
+	POP	IX
+	RET
+f131:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1131:	LD	SP,IX
+	POP	IX
+	RET
+f132:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1132:	LD	SP,IX
+	POP	IX
+	RET
+f133:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1133:	LD	SP,IX
+	POP	IX
+	RET
+f134:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1134:	LD	SP,IX
+	POP	IX
+	RET
+f135:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1135:	LD	SP,IX
+	POP	IX
+	RET
+f136:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1136:	LD	SP,IX
+	POP	IX
+	RET
+f137:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1137:	LD	SP,IX
+	POP	IX
+	RET
+f138:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1138:	LD	SP,IX
+	POP	IX
+	RET
+f139:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1139:	LD	SP,IX
+	POP	IX
+	RET
+f140:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1140:	LD	SP,IX
+	POP	IX
+	RET
+f141:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1141:	LD	SP,IX
+	POP	IX
+	RET
+f142:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1142:	LD	SP,IX
+	POP	IX
+	RET
+f143:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1143:	LD	SP,IX
+	POP	IX
+	RET
+f144:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1144:	LD	SP,IX
+	POP	IX
+	RET
+f145:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1145:	LD	SP,IX
+	POP	IX
+	RET
+f146:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1146:	LD	SP,IX
+	POP	IX
+	RET
+f147:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1147:	LD	SP,IX
+	POP	IX
+	RET
+f148:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1148:	LD	SP,IX
+	POP	IX
+	RET
+f149:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1149:	LD	SP,IX
+	POP	IX
+	RET
+f150:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1150:	LD	SP,IX
+	POP	IX
+	RET
+f151:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1151:	LD	SP,IX
+	POP	IX
+	RET
+f152:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1152:	LD	SP,IX
+	POP	IX
+	RET
+f153:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1153:	LD	SP,IX
+	POP	IX
+	RET
+f154:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1154:	LD	SP,IX
+	POP	IX
+	RET
+f155:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1155:	LD	SP,IX
+	POP	IX
+	RET
+f156:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1156:	LD	SP,IX
+	POP	IX
+	RET
+f157:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1157:	LD	SP,IX
+	POP	IX
+	RET
+f158:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1158:	LD	SP,IX
+	POP	IX
+	RET
+f159:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1159:	LD	SP,IX
+	POP	IX
+	RET
+f160:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1160:	LD	SP,IX
+	POP	IX
+	RET
+f161:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1161:	LD	SP,IX
+	POP	IX
+	RET
+f162:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1162:	LD	SP,IX
+	POP	IX
+	RET
+f163:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1163:	LD	SP,IX
+	POP	IX
+	RET
+f164:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1164:	LD	SP,IX
+	POP	IX
+	RET
+f165:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1165:	LD	SP,IX
+	POP	IX
+	RET
+f166:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1166:	LD	SP,IX
+	POP	IX
+	RET
+f167:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1167:	LD	SP,IX
+	POP	IX
+	RET
+f168:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1168:	LD	SP,IX
+	POP	IX
+	RET
+f169:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1169:	LD	SP,IX
+	POP	IX
+	RET
+f170:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1170:	LD	SP,IX
+	POP	IX
+	RET
+f171:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1171:	LD	SP,IX
+	POP	IX
+	RET
+f172:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1172:	LD	SP,IX
+	POP	IX
+	RET
+f173:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1173:	LD	SP,IX
+	POP	IX
+	RET
+f174:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1174:	LD	SP,IX
+	POP	IX
+	RET
+f175:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1175:	LD	SP,IX
+	POP	IX
+	RET
+f176:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1176:	LD	SP,IX
+	POP	IX
+	RET
+f177:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1177:	LD	SP,IX
+	POP	IX
+	RET
+f178:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1178:	LD	SP,IX
+	POP	IX
+	RET
+f179:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1179:	LD	SP,IX
+	POP	IX
+	RET
+f180:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1180:	LD	SP,IX
+	POP	IX
+	RET
+f181:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1181:	LD	SP,IX
+	POP	IX
+	RET
+f182:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1182:	LD	SP,IX
+	POP	IX
+	RET
+f183:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1183:	LD	SP,IX
+	POP	IX
+	RET
+f184:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1184:	LD	SP,IX
+	POP	IX
+	RET
+f185:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1185:	LD	SP,IX
+	POP	IX
+	RET
+f186:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1186:	LD	SP,IX
+	POP	IX
+	RET
+f187:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1187:	LD	SP,IX
+	POP	IX
+	RET
+f188:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1188:	LD	SP,IX
+	POP	IX
+	RET
+f189:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1189:	LD	SP,IX
+	POP	IX
+	RET
+f190:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1190:	LD	SP,IX
+	POP	IX
+	RET
+f191:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1191:	LD	SP,IX
+	POP	IX
+	RET
+f192:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1192:	LD	SP,IX
+	POP	IX
+	RET
+f193:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1193:	LD	SP,IX
+	POP	IX
+	RET
+f194:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1194:	LD	SP,IX
+	POP	IX
+	RET
+f195:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1195:	LD	SP,IX
+	POP	IX
+	RET
+f196:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1196:	LD	SP,IX
+	POP	IX
+	RET
+f197:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1197:	LD	SP,IX
+	POP	IX
+	RET
+f198:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1198:	LD	SP,IX
+	POP	IX
+	RET
+f199:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1199:	LD	SP,IX
+	POP	IX
+	RET
+f200:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1200:	LD	SP,IX
+	POP	IX
+	RET
+f201:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1201:	LD	SP,IX
+	POP	IX
+	RET
+f202:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1202:	LD	SP,IX
+	POP	IX
+	RET
+f203:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1203:	LD	SP,IX
+	POP	IX
+	RET
+f204:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1204:	LD	SP,IX
+	POP	IX
+	RET
+f205:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1205:	LD	SP,IX
+	POP	IX
+	RET
+f206:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1206:	LD	SP,IX
+	POP	IX
+	RET
+f207:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1207:	LD	SP,IX
+	POP	IX
+	RET
+f208:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1208:	LD	SP,IX
+	POP	IX
+	RET
+f209:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1209:	LD	SP,IX
+	POP	IX
+	RET
+f210:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1210:	LD	SP,IX
+	POP	IX
+	RET
+f211:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1211:	LD	SP,IX
+	POP	IX
+	RET
+f212:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1212:	LD	SP,IX
+	POP	IX
+	RET
+f213:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1213:	LD	SP,IX
+	POP	IX
+	RET
+f214:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1214:	LD	SP,IX
+	POP	IX
+	RET
+f215:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1215:	LD	SP,IX
+	POP	IX
+	RET
+f216:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1216:	LD	SP,IX
+	POP	IX
+	RET
+f217:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1217:	LD	SP,IX
+	POP	IX
+	RET
+f218:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1218:	LD	SP,IX
+	POP	IX
+	RET
+f219:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1219:	LD	SP,IX
+	POP	IX
+	RET
+f220:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1220:	LD	SP,IX
+	POP	IX
+	RET
+f221:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1221:	LD	SP,IX
+	POP	IX
+	RET
+f222:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1222:	LD	SP,IX
+	POP	IX
+	RET
+f223:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1223:	LD	SP,IX
+	POP	IX
+	RET
+f224:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1224:	LD	SP,IX
+	POP	IX
+	RET
+f225:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1225:	LD	SP,IX
+	POP	IX
+	RET
+f226:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1226:	LD	SP,IX
+	POP	IX
+	RET
+f227:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1227:	LD	SP,IX
+	POP	IX
+	RET
+f228:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1228:	LD	SP,IX
+	POP	IX
+	RET
+f229:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1229:	LD	SP,IX
+	POP	IX
+	RET
+f230:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1230:	LD	SP,IX
+	POP	IX
+	RET
+f231:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1231:	LD	SP,IX
+	POP	IX
+	RET
+f232:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1232:	LD	SP,IX
+	POP	IX
+	RET
+f233:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1233:	LD	SP,IX
+	POP	IX
+	RET
+f234:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1234:	LD	SP,IX
+	POP	IX
+	RET
+f235:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1235:	LD	SP,IX
+	POP	IX
+	RET
+f236:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1236:	LD	SP,IX
+	POP	IX
+	RET
+f237:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1237:	LD	SP,IX
+	POP	IX
+	RET
+f238:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1238:	LD	SP,IX
+	POP	IX
+	RET
+f239:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1239:	LD	SP,IX
+	POP	IX
+	RET
+f240:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1240:	LD	SP,IX
+	POP	IX
+	RET
+f241:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1241:	LD	SP,IX
+	POP	IX
+	RET
+f242:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1242:	LD	SP,IX
+	POP	IX
+	RET
+f243:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1243:	LD	SP,IX
+	POP	IX
+	RET
+f244:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1244:	LD	SP,IX
+	POP	IX
+	RET
+f245:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1245:	LD	SP,IX
+	POP	IX
+	RET
+f246:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1246:	LD	SP,IX
+	POP	IX
+	RET
+f247:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1247:	LD	SP,IX
+	POP	IX
+	RET
+f248:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1248:	LD	SP,IX
+	POP	IX
+	RET
+f249:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1249:	LD	SP,IX
+	POP	IX
+	RET
+f250:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1250:	LD	SP,IX
+	POP	IX
+	RET
+f251:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1251:	LD	SP,IX
+	POP	IX
+	RET
+f252:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1252:	LD	SP,IX
+	POP	IX
+	RET
+f253:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1253:	LD	SP,IX
+	POP	IX
+	RET
+f254:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1254:	LD	SP,IX
+	POP	IX
+	RET
+f255:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1255:	LD	SP,IX
+	POP	IX
+	RET
+f256:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1256:	LD	SP,IX
+	POP	IX
+	RET
+f257:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1257:	LD	SP,IX
+	POP	IX
+	RET
+f258:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1258:	LD	SP,IX
+	POP	IX
+	RET
+f259:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1259:	LD	SP,IX
+	POP	IX
+	RET
+f260:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1260:	LD	SP,IX
+	POP	IX
+	RET
+f261:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1261:	LD	SP,IX
+	POP	IX
+	RET
+f262:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1262:	LD	SP,IX
+	POP	IX
+	RET
+f263:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1263:	LD	SP,IX
+	POP	IX
+	RET
+f264:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1264:	LD	SP,IX
+	POP	IX
+	RET
+f265:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1265:	LD	SP,IX
+	POP	IX
+	RET
+f266:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1266:	LD	SP,IX
+	POP	IX
+	RET
+f267:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1267:	LD	SP,IX
+	POP	IX
+	RET
+f268:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1268:	LD	SP,IX
+	POP	IX
+	RET
+f269:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1269:	LD	SP,IX
+	POP	IX
+	RET
+f270:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1270:	LD	SP,IX
+	POP	IX
+	RET
+f271:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1271:	LD	SP,IX
+	POP	IX
+	RET
+f272:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1272:	LD	SP,IX
+	POP	IX
+	RET
+f273:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1273:	LD	SP,IX
+	POP	IX
+	RET
+f274:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1274:	LD	SP,IX
+	POP	IX
+	RET
+f275:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1275:	LD	SP,IX
+	POP	IX
+	RET
+f276:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1276:	LD	SP,IX
+	POP	IX
+	RET
+f277:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1277:	LD	SP,IX
+	POP	IX
+	RET
+f278:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1278:	LD	SP,IX
+	POP	IX
+	RET
+f279:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1279:	LD	SP,IX
+	POP	IX
+	RET
+f280:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1280:	LD	SP,IX
+	POP	IX
+	RET
+f281:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1281:	LD	SP,IX
+	POP	IX
+	RET
+f282:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1282:	LD	SP,IX
+	POP	IX
+	RET
+f283:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1283:	LD	SP,IX
+	POP	IX
+	RET
+f284:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1284:	LD	SP,IX
+	POP	IX
+	RET
+f285:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1285:	LD	SP,IX
+	POP	IX
+	RET
+f286:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1286:	LD	SP,IX
+	POP	IX
+	RET
+f287:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1287:	LD	SP,IX
+	POP	IX
+	RET
+f288:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1288:	LD	SP,IX
+	POP	IX
+	RET
+f289:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1289:	LD	SP,IX
+	POP	IX
+	RET
+f290:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1290:	LD	SP,IX
+	POP	IX
+	RET
+f291:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1291:	LD	SP,IX
+	POP	IX
+	RET
+f292:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1292:	LD	SP,IX
+	POP	IX
+	RET
+f293:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1293:	LD	SP,IX
+	POP	IX
+	RET
+f294:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1294:	LD	SP,IX
+	POP	IX
+	RET
+f295:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	LD	C,A
+L1295:	LD	SP,IX
+	POP	IX
+	RET
+f296:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	LD	C,A
+L1296:	LD	SP,IX
+	POP	IX
+	RET
+f297:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	INC	A
+	INC	A
+	INC	A
+	LD	C,A
+L1297:	LD	SP,IX
+	POP	IX
+	RET
+f298:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,4
+	LD	C,A
+L1298:	LD	SP,IX
+	POP	IX
+	RET
+f299:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	A,B
+	ADD	A,5
+	LD	C,A
+L1299:	LD	SP,IX
+	POP	IX
+	RET
@@ -0,0 +1,26 @@
+int a, b;
+char c;
+
+int
+f(void)
+{
+	int i;
+	char k;
+
+	i = a;
+	k = c + 1;
+	i += 3;
+	i++;
+	c = k & 7;
+	b = i - 2;
+	return i + a;
+}
+
+int g;
+
+char
+h(void)
+{
+	c = c - 1;
+	return c;
+}
@@ -0,0 +1,39 @@
+f:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	BC,(a)
+	LD	A,(c)
+	INC	A
+	LD	E,A
+	LD	HL,3
+	ADD	HL,BC
+	LD	C,L
+	LD	B,H
+	INC	BC
+	AND	A,7
+	LD	(c),A
+	LD	L,C
+	LD	H,B
+	LD	A,L
+	SUB	A,2
+	LD	L,A
+	LD	A,H
+	SBC	A,0
+	LD	H,A
+	LD	(b),HL
+	LD	HL,(a)
+	ADD	HL,BC
+L1000:	LD	SP,IX
+	POP	IX
+	RET
+h:
+	PUSH	IX
+	LD	IX,SP
+	LD	HL,c
+	DEC	(HL)
+	LD	A,(c)
+L1001:	LD	SP,IX
+	POP	IX
+	RET
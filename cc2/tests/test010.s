@@ -0,0 +1,10 @@
+f:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	LD	A,(IX+4)
+	ADD	A,(IX+6)
+	LD	C,A
+L1000:	LD	SP,IX
+	POP	IX
+	RET
@@ -0,0 +1,8 @@
+int
+add(int x, char y)
+{
+	int i;
+
+	i = x - y;
+	return i + x;
+}
@@ -0,0 +1,21 @@
+add:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	LD	A,(IX+6)
+	LD	L,A
+	LD	H,0
+	LD	E,L
+	LD	D,H
+	LD	L,(IX+4)
+	LD	H,(IX+5)
+	OR	A,A
+	SBC	HL,DE
+	LD	C,L
+	LD	B,H
+	LD	L,(IX+4)
+	LD	H,(IX+5)
+	ADD	HL,BC
+L1000:	LD	SP,IX
+	POP	IX
+	RET
@@ -0,0 +1,8 @@
+cannot encode 'LD A,(IX+142)'
+f:
+	PUSH	IX
+	LD	IX,SP
+	LD	A,(IX+142)
+L1000:	LD	SP,IX
+	POP	IX
+	RET
@@ -0,0 +1,13 @@
+int i;
+unsigned u;
+char c;
+
+int
+f(int n)
+{
+	i = i << 3;
+	u = u >> 2;
+	c = c << 1;
+	i = i >> 1;
+	return u << n;
+}
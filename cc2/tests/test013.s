@@ -0,0 +1,32 @@
+f:
+	PUSH	IX
+	LD	IX,SP
+	LD	HL,(i)
+	ADD	HL,HL
+	ADD	HL,HL
+	ADD	HL,HL
+	LD	(i),HL
+	LD	HL,(u)
+	SRL	H
+	RR	L
+	SRL	H
+	RR	L
+	LD	(u),HL
+	LD	A,(c)
+	ADD	A,A
+	LD	(c),A
+	LD	HL,(i)
+	SRA	H
+	RR	L
+	LD	(i),HL
+	LD	L,(IX+4)
+	LD	H,(IX+5)
+	PUSH	HL
+	LD	HL,(u)
+	PUSH	HL
+	CALL	__shl16
+	POP	AF
+	POP	AF
+L1000:	LD	SP,IX
+	POP	IX
+	RET
@@ -0,0 +1,12 @@
+int i, j;
+unsigned u;
+
+int
+f(int k)
+{
+	i = i * 3;
+	j = i * k;
+	u = u / 10;
+	k = j % i;
+	return k / 4;
+}
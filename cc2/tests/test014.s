@@ -0,0 +1,71 @@
+f:
+	PUSH	IX
+	LD	IX,SP
+	LD	DE,(i)
+	LD	HL,(i)
+	ADD	HL,HL
+	ADD	HL,DE
+	LD	(i),HL
+	LD	L,(IX+4)
+	LD	H,(IX+5)
+	PUSH	HL
+	LD	HL,(i)
+	PUSH	HL
+	CALL	__mul16
+	POP	AF
+	POP	AF
+	LD	(j),HL
+	LD	HL,10
+	PUSH	HL
+	LD	HL,(u)
+	PUSH	HL
+	CALL	__udiv16
+	POP	AF
+	POP	AF
+	LD	(u),HL
+	LD	HL,(i)
+	PUSH	HL
+	LD	HL,(j)
+	PUSH	HL
+	CALL	__mod16
+	POP	AF
+	POP	AF
+	LD	(IX+4),L
+	LD	(IX+5),H
+	LD	L,H
+	LD	A,H
+	ADD	A,A
+	SBC	A,A
+	LD	H,A
+	SRA	H
+	RR	L
+	SRA	H
+	RR	L
+	SRA	H
+	RR	L
+	SRA	H
+	RR	L
+	SRA	H
+	RR	L
+	SRA	H
+	RR	L
+	SRA	H
+	RR	L
+	LD	A,L
+	AND	A,3
+	LD	L,A
+	LD	A,H
+	AND	A,0
+	LD	H,A
+	LD	E,L
+	LD	D,H
+	LD	L,(IX+4)
+	LD	H,(IX+5)
+	ADD	HL,DE
+	SRA	H
+	RR	L
+	SRA	H
+	RR	L
+L1000:	LD	SP,IX
+	POP	IX
+	RET
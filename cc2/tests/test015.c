@@ -0,0 +1,16 @@
+int i;
+unsigned u;
+
+int
+f(int a, int b)
+{
+	if (a < b)
+		return 1;
+	if (u >= 10 && a > 3)
+		return 2;
+	if (a == 0 || i != b)
+		return 3;
+	while (i > 0)
+		i--;
+	return a <= b;
+}
@@ -0,0 +1,73 @@
+f:
+	PUSH	IX
+	LD	IX,SP
+	LD	L,(IX+4)
+	LD	H,(IX+5)
+	LD	A,L
+	SUB	A,(IX+6)
+	LD	A,H
+	SBC	A,(IX+7)
+	JP	PO,L1000_0
+	XOR	A,128
+L1000_0:	JP	P,L7
+	LD	HL,1
+	JP	L1000
+L7:	LD	DE,10
+	LD	HL,(u)
+	OR	A,A
+	SBC	HL,DE
+	JP	C,L8
+	LD	L,(IX+4)
+	LD	H,(IX+5)
+	LD	A,3
+	SUB	A,L
+	LD	A,0
+	SBC	A,H
+	JP	PO,L1000_1
+	XOR	A,128
+L1000_1:	JP	P,L8
+	LD	HL,2
+	JP	L1000
+L8:	LD	L,(IX+4)
+	LD	H,(IX+5)
+	LD	A,L
+	OR	A,H
+	JP	Z,L1000_2
+	LD	HL,(i)
+	LD	A,L
+	XOR	A,(IX+6)
+	LD	L,A
+	LD	A,H
+	XOR	A,(IX+7)
+	OR	A,L
+	JP	Z,L12
+L1000_2:	LD	HL,3
+	JP	L1000
+L9:	JP	L12
+L10:	LD	HL,(i)
+	DEC	HL
+	LD	(i),HL
+L12:	LD	HL,(i)
+	XOR	A,A
+	SUB	A,L
+	LD	A,0
+	SBC	A,H
+	JP	PO,L1000_3
+	XOR	A,128
+L1000_3:	JP	M,L10
+L11:	LD	L,(IX+6)
+	LD	H,(IX+7)
+	LD	A,L
+	SUB	A,(IX+4)
+	LD	A,H
+	SBC	A,(IX+5)
+	JP	PO,L1000_6
+	XOR	A,128
+L1000_6:	JP	M,L1000_4
+	LD	HL,1
+	JP	L1000
+L1000_4:	LD	HL,0
+L1000_5:	JP	L1000
+L1000:	LD	SP,IX
+	POP	IX
+	RET
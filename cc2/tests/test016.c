@@ -0,0 +1,13 @@
+long l, m;
+unsigned long ul;
+
+long
+f(long x)
+{
+	l = l + m;
+	m = x - 1;
+	ul = ul & 0xFF00;
+	if (l < m)
+		return ul;
+	return l + x;
+}
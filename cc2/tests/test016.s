@@ -0,0 +1,82 @@
+f:
+	PUSH	IX
+	LD	IX,SP
+	LD	HL,(l)
+	LD	DE,(l+2)
+	LD	A,L
+	LD	IY,m
+	ADD	A,(IY+0)
+	LD	(l),A
+	LD	A,H
+	LD	IY,m+1
+	ADC	A,(IY+0)
+	LD	(l+1),A
+	LD	A,E
+	LD	IY,m+2
+	ADC	A,(IY+0)
+	LD	(l+2),A
+	LD	A,D
+	LD	IY,m+3
+	ADC	A,(IY+0)
+	LD	(l+3),A
+	LD	A,(IX+4)
+	SUB	A,1
+	LD	(m),A
+	LD	A,(IX+5)
+	SBC	A,0
+	LD	(m+1),A
+	LD	A,(IX+6)
+	SBC	A,0
+	LD	(m+2),A
+	LD	A,(IX+7)
+	SBC	A,0
+	LD	(m+3),A
+	LD	HL,(ul)
+	LD	DE,(ul+2)
+	LD	A,L
+	AND	A,0
+	LD	(ul),A
+	LD	A,H
+	AND	A,255
+	LD	(ul+1),A
+	LD	A,E
+	AND	A,0
+	LD	(ul+2),A
+	LD	A,D
+	AND	A,0
+	LD	(ul+3),A
+	LD	A,(l)
+	LD	IY,m
+	SUB	A,(IY+0)
+	LD	A,(l+1)
+	LD	IY,m+1
+	SBC	A,(IY+0)
+	LD	A,(l+2)
+	LD	IY,m+2
+	SBC	A,(IY+0)
+	LD	A,(l+3)
+	LD	IY,m+3
+	SBC	A,(IY+0)
+	JP	PO,L1000_0
+	XOR	A,128
+L1000_0:	JP	P,L7
+	LD	HL,(ul)
+	LD	DE,(ul+2)
+	JP	L1000
+L7:	LD	HL,(l)
+	LD	DE,(l+2)
+	LD	A,L
+	ADD	A,(IX+4)
+	LD	L,A
+	LD	A,H
+	ADC	A,(IX+5)
+	LD	H,A
+	LD	A,E
+	ADC	A,(IX+6)
+	LD	E,A
+	LD	A,D
+	ADC	A,(IX+7)
+	LD	D,A
+L1000:	LD	SP,IX
+	POP	IX
+	RET
@@ -0,0 +1,11 @@
+int g(int a, char b, long c);
+void v(void);
+int (*fp)();
+
+int
+f(int i)
+{
+	v();
+	i = g(i, 2, 3L) + 1;
+	return (*fp)(i) + g(1, 2, 3);
+}
@@ -0,0 +1,52 @@
+f:
+	PUSH	IX
+	LD	IX,SP
+	CALL	v
+	LD	HL,3
+	LD	DE,0
+	PUSH	DE
+	PUSH	HL
+	LD	A,2
+	LD	L,A
+	PUSH	HL
+	LD	L,(IX+4)
+	LD	H,(IX+5)
+	PUSH	HL
+	CALL	g
+	POP	AF
+	POP	AF
+	POP	AF
+	POP	AF
+	INC	HL
+	LD	(IX+4),L
+	LD	(IX+5),H
+	LD	HL,3
+	LD	DE,0
+	PUSH	DE
+	PUSH	HL
+	LD	A,2
+	LD	L,A
+	PUSH	HL
+	LD	HL,1
+	PUSH	HL
+	CALL	g
+	POP	AF
+	POP	AF
+	POP	AF
+	POP	AF
+	LD	C,L
+	LD	B,H
+	PUSH	BC
+	LD	L,(IX+4)
+	LD	H,(IX+5)
+	PUSH	HL
+	LD	HL,(fp)
+	CALL	L1000_0
+	JP	L1000_1
+L1000_0:	JP	(HL)
+L1000_1:	POP	AF
+	POP	BC
+	ADD	HL,BC
+L1000:	LD	SP,IX
+	POP	IX
+	RET
@@ -0,0 +1,18 @@
+int
+f(int x)
+{
+	int r;
+
+	r = 0;
+	switch (x) {
+	case 1:
+		r = 1;
+	case 2:
+		r = 2;
+	case 300:
+		r += 3;
+	default:
+		r = -r;
+	}
+	return r;
+}
@@ -0,0 +1,45 @@
+f:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	LD	BC,0
+	LD	L,(IX+4)
+	LD	H,(IX+5)
+	JP	L6
+L7:	NOP
+L8:	LD	BC,2
+L9:	LD	HL,3
+	ADD	HL,BC
+	LD	C,L
+	LD	B,H
+L10:	LD	L,C
+	LD	H,B
+	XOR	A,A
+	SUB	A,L
+	LD	L,A
+	SBC	A,A
+	SUB	A,H
+	LD	H,A
+	LD	C,L
+	LD	B,H
+	JP	L5
+L6:	LD	DE,65236
+	ADD	HL,DE
+	LD	A,H
+	OR	A,L
+	JP	Z,L9
+	LD	DE,298
+	ADD	HL,DE
+	LD	A,H
+	OR	A,L
+	JP	Z,L8
+	INC	HL
+	LD	A,H
+	OR	A,L
+	JP	Z,L7
+	JP	L10
+L5:	LD	L,C
+	LD	H,B
+L1000:	LD	SP,IX
+	POP	IX
+	RET
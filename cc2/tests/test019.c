@@ -0,0 +1,13 @@
+struct s {
+	int x, y, z;
+	char *p;
+};
+
+struct s a[10];
+
+int
+f(int i)
+{
+	a[i].x = a[i].y + a[i].z;
+	return a[i].x + *a[i].p;
+}
@@ -0,0 +1,65 @@
+f:
+	PUSH	IX
+	LD	IX,SP
+	PUSH	HL
+	PUSH	HL
+	LD	L,(IX+4)
+	LD	H,(IX+5)
+	ADD	HL,HL
+	ADD	HL,HL
+	ADD	HL,HL
+	PUSH	DE
+	LD	DE,a
+	ADD	HL,DE
+	POP	DE
+	LD	C,L
+	LD	B,H
+	LD	HL,2
+	ADD	HL,BC
+	LD	A,(HL)
+	INC	HL
+	LD	H,(HL)
+	LD	L,A
+	PUSH	BC
+	POP	IY
+	LD	A,L
+	ADD	A,(IY+4)
+	LD	L,A
+	LD	A,H
+	ADC	A,(IY+5)
+	LD	H,A
+	PUSH	BC
+	POP	IY
+	LD	(IY+0),L
+	LD	(IY+1),H
+	LD	L,(IX+4)
+	LD	H,(IX+5)
+	ADD	HL,HL
+	ADD	HL,HL
+	ADD	HL,HL
+	PUSH	DE
+	LD	DE,a
+	ADD	HL,DE
+	POP	DE
+	LD	E,L
+	LD	D,H
+	LD	HL,6
+	ADD	HL,DE
+	LD	A,(HL)
+	INC	HL
+	LD	H,(HL)
+	LD	L,A
+	LD	A,(HL)
+	LD	L,A
+	LD	H,0
+	PUSH	DE
+	POP	IY
+	LD	A,L
+	ADD	A,(IY+0)
+	LD	L,A
+	LD	A,H
+	ADC	A,(IY+1)
+	LD	H,A
+L1000:	LD	SP,IX
+	POP	IX
+	RET
@@ -13,5 +13,7 @@ LD = $(CC)
 AR = ar
 
 # for Plan9 add -D_SUSV2_SOURCE -DNBOOL
+# for memory accounting at exit add -DMEMSTATS (it uses pthreads)
+# for the counters of the peephole rules at exit add -DPEEPSTATS
 CFLAGS   = -DNDEBUG -Iarch/$(ARCH) -O2 -std=c99
 LDFLAGS  = -s
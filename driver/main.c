@@ -0,0 +1,133 @@
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../inc/cc.h"
+
+#define NR_QUEUE 4
+
+/*
+ * scc links the front end and the back end in the same binary.
+ * cc1 keeps the IR of every function in memory in the binary
+ * form, and irfun passes that buffer to cc2 when the function
+ * ends. cc2 does not get the trees of cc1, it parses the buffer
+ * and builds its own nodes, but there is no text IR to format and
+ * scan, no pipe and no second process.
+ */
+extern int cc1main(int argc, char *argv[]);
+extern void (*irfun)(char *buf, size_t len);
+extern void binaryir(void);
+extern void setinput(char *buf, size_t len);
+extern void codegen(void);
+extern void initjobs(int n);
+extern void endjobs(void);
+extern void initobj(void);
+
+/*
+ * With -pipeline cc2 runs in its own thread, and cc1 parses the
+ * next function while cc2 generates the code of the previous one.
+ * The functions are passed through a queue of NR_QUEUE entries,
+ * and cc1 waits when it is full, so the memory used does not
+ * depend on the size of the translation unit.
+ */
+static struct fun {
+	char *buf;
+	size_t len;
+} queue[NR_QUEUE];
+static int qhead, qlen, qend;
+static pthread_mutex_t qlock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t qput = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t qget = PTHREAD_COND_INITIALIZER;
+
+static void
+backend(char *buf, size_t len)
+{
+	setinput(buf, len);
+	codegen();
+}
+
+static void
+enqueue(char *buf, size_t len)
+{
+	struct fun *fp;
+
+	pthread_mutex_lock(&qlock);
+	while (qlen == NR_QUEUE)
+		pthread_cond_wait(&qget, &qlock);
+	fp = &queue[(qhead + qlen++) % NR_QUEUE];
+	fp->buf = memcpy(xmalloc(len), buf, len);
+	fp->len = len;
+	pthread_cond_signal(&qput);
+	pthread_mutex_unlock(&qlock);
+}
+
+static void *
+worker(void *arg)
+{
+	struct fun f;
+
+	for (;;) {
+		pthread_mutex_lock(&qlock);
+		while (qlen == 0 && !qend)
+			pthread_cond_wait(&qput, &qlock);
+		if (qlen == 0) {
+			pthread_mutex_unlock(&qlock);
+			return NULL;
+		}
+		f = queue[qhead];
+		qhead = (qhead + 1) % NR_QUEUE;
+		--qlen;
+		pthread_cond_signal(&qget);
+		pthread_mutex_unlock(&qlock);
+
+		backend(f.buf, f.len);
+		xfree(f.buf);
+	}
+}
+
+int
+main(int argc, char *argv[])
+{
+	int r, ir = 0, pipeline = 0;
+	pthread_t thr;
+
+	for ( ; argc > 1; --argc, ++argv) {
+		/* with -ir only the front end runs, and it writes the IR */
+		if (!strcmp(argv[1], "-ir"))
+			ir = 1;
+		else if (!strcmp(argv[1], "-pipeline"))
+			pipeline = 1;
+		else if (!strcmp(argv[1], "-c"))
+			initobj();
+		else if (!strncmp(argv[1], "-j", 2))
+			initjobs(atoi(argv[1] + 2));
+		else
+			break;
+		argv[1] = argv[0];
+	}
+	if (ir)
+		return cc1main(argc, argv);
+
+	binaryir();
+	if (!pipeline) {
+		irfun = backend;
+		r = cc1main(argc, argv);
+		endjobs();
+		return r;
+	}
+
+	irfun = enqueue;
+	if (pthread_create(&thr, NULL, worker, NULL))
+		die("error creating the back end thread");
+	r = cc1main(argc, argv);
+
+	pthread_mutex_lock(&qlock);
+	qend = 1;
+	pthread_cond_signal(&qput);
+	pthread_mutex_unlock(&qlock);
+	pthread_join(thr, NULL);
+	endjobs();
+	return r;
+}
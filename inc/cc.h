@@ -41,9 +41,28 @@ extern int debug;
 #define L_AUTO      'A'
 #define L_EXTERN    'X'
 
+#define IR_MAGIC    0xFF        /* first byte of the binary IR */
+
+/* memory accounting categories, only tracked with -DMEMSTATS */
+enum {
+	MEM_OTHER,
+	MEM_SYMBOL,
+	MEM_TYPE,
+	MEM_NODE,
+	MEM_STRING,
+	MEM_INPUT,
+	MEM_INST,
+	NR_MEMCAT
+};
+
 extern void die(const char *fmt, ...);
 extern void dbg(const char *fmt, ...);
 extern void *xmalloc(size_t size);
 extern void *xcalloc(size_t nmemb, size_t size);
 extern char *xstrdup(const char *s);
 extern void *xrealloc(void *buff, register size_t size);
+extern void xfree(void *p);
+extern void *xmalloctag(size_t size, int cat);
+extern void *xcalloctag(size_t nmemb, size_t size, int cat);
+extern void *xrealloctag(void *buff, size_t size, int cat);
+extern void memstats(void);
@@ -0,0 +1,168 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef MEMSTATS
+#include <pthread.h>
+#endif
+
+#include "../inc/cc.h"
+
+#ifdef MEMSTATS
+/*
+ * Every block carries a small header with its size and category,
+ * so the accounting can be updated when the block is released.
+ * The category is given when the block is allocated, and a
+ * reallocation moves the block to the new category.
+ * The union forces the worst alignment of the basic types. The
+ * counters are shared by all the threads, so they are updated with
+ * the lock held.
+ */
+union hdr {
+	struct {
+		size_t size;
+		int cat;
+	} h;
+	long double ld;
+	long long ll;
+	void *p;
+};
+
+static struct memcat {
+	size_t nalloc;
+	size_t bytes;
+	size_t live;
+	size_t peak;
+} cats[NR_MEMCAT];
+static size_t live, peak, churn;
+static pthread_mutex_t statlock = PTHREAD_MUTEX_INITIALIZER;
+
+static char *catnames[] = {
+	[MEM_OTHER] = "other",
+	[MEM_SYMBOL] = "symbols",
+	[MEM_TYPE] = "types",
+	[MEM_NODE] = "nodes",
+	[MEM_STRING] = "strings",
+	[MEM_INPUT] = "input",
+	[MEM_INST] = "instructions"
+};
+
+static void
+count(int cat, size_t size)
+{
+	struct memcat *mp = &cats[cat];
+
+	++mp->nalloc;
+	mp->bytes += size;
+	if ((mp->live += size) > mp->peak)
+		mp->peak = mp->live;
+	churn += size;
+	if ((live += size) > peak)
+		peak = live;
+}
+
+static void
+uncount(int cat, size_t size)
+{
+	cats[cat].live -= size;
+	live -= size;
+	churn += size;
+}
+
+void *
+xrealloctag(void *buff, size_t size, int cat)
+{
+	union hdr *hp = NULL;
+
+	if (buff)
+		hp = (union hdr *) buff - 1;
+	pthread_mutex_lock(&statlock);
+	if (buff)
+		uncount(hp->h.cat, hp->h.size);
+	count(cat, size);
+	pthread_mutex_unlock(&statlock);
+	if ((hp = realloc(hp, sizeof(*hp) + size)) == NULL)
+		die("out of memory");
+	hp->h.size = size;
+	hp->h.cat = cat;
+	return hp + 1;
+}
+
+void
+xfree(void *p)
+{
+	union hdr *hp;
+
+	if (!p)
+		return;
+	hp = (union hdr *) p - 1;
+	pthread_mutex_lock(&statlock);
+	uncount(hp->h.cat, hp->h.size);
+	pthread_mutex_unlock(&statlock);
+	free(hp);
+}
+
+void *
+xrealloc(void *buff, size_t size)
+{
+	int cat = MEM_OTHER;
+
+	if (buff)
+		cat = ((union hdr *) buff - 1)->h.cat;
+	return xrealloctag(buff, size, cat);
+}
+
+void
+memstats(void)
+{
+	struct memcat *mp;
+	int cat;
+
+	pthread_mutex_lock(&statlock);
+	fprintf(stderr, "%-14s %10s %12s %12s %12s\n",
+	        "memory", "allocs", "bytes", "live", "peak");
+	for (cat = 0; cat < NR_MEMCAT; ++cat) {
+		mp = &cats[cat];
+		if (mp->nalloc == 0)
+			continue;
+		fprintf(stderr, "%-14s %10lu %12lu %12lu %12lu\n",
+		        catnames[cat],
+		        (unsigned long) mp->nalloc,
+		        (unsigned long) mp->bytes,
+		        (unsigned long) mp->live,
+		        (unsigned long) mp->peak);
+	}
+	fprintf(stderr, "peak live bytes: %lu, total churn: %lu bytes\n",
+	        (unsigned long) peak, (unsigned long) churn);
+	pthread_mutex_unlock(&statlock);
+}
+
+#else
+
+void *
+xrealloctag(void *buff, size_t size, int cat)
+{
+	void *p = realloc(buff, size);
+
+	if (!p)
+		die("out of memory");
+	return p;
+}
+
+void *
+xrealloc(void *buff, size_t size)
+{
+	return xrealloctag(buff, size, MEM_OTHER);
+}
+
+void
+xfree(void *p)
+{
+	free(p);
+}
+
+void
+memstats(void)
+{
+}
+
+#endif
@@ -1,13 +1,22 @@
 
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include "../inc/cc.h"
 
 void *
-xcalloc(size_t n, size_t size)
+xcalloctag(size_t n, size_t size, int cat)
 {
-	void *p = calloc(n, size);
+	void *p;
 
-	if (!p)
+	if (size && n > SIZE_MAX / size)
 		die("out of memory");
-	return p;
+	p = xrealloctag(NULL, n * size, cat);
+	return memset(p, 0, n * size);
+}
+
+void *
+xcalloc(size_t n, size_t size)
+{
+	return xcalloctag(n, size, MEM_OTHER);
 }
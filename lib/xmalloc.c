@@ -1,13 +1,14 @@
-
 #include <stdlib.h>
 #include "../inc/cc.h"
 
 void *
 xmalloc(size_t size)
 {
-	void *p = malloc(size);
+	return xrealloctag(NULL, size, MEM_OTHER);
+}
 
-	if (!p)
-		die("out of memory");
-	return p;
+void *
+xmalloctag(size_t size, int cat)
+{
+	return xrealloctag(NULL, size, cat);
 }
@@ -6,7 +6,7 @@ char *
 xstrdup(const char *s)
 {
 	size_t len = strlen(s) + 1;
-	char *p = xmalloc(len);
+	char *p = xmalloctag(len, MEM_STRING);
 
 	return memcpy(p, s, len);
 }